@@ -0,0 +1,49 @@
+#include "bench.h"
+
+#include <spdlog/fmt/fmt.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace explore::bench {
+
+static f64 median(std::vector<f64> values) {
+    std::sort(values.begin(), values.end());
+    const size_t middle{values.size() / 2};
+    return values.size() % 2 == 1
+               ? values[middle]
+               : (values[middle - 1] + values[middle]) / 2.0;
+}
+
+void Bench::print_header() const {
+    fmt::print("{} warm-up and {} timed runs per benchmark\n",
+               _options.warmup, _options.repetitions);
+    fmt::print("{:<36} {:>10} {:>12} {:>12} {:>12} {:>7}\n", "benchmark",
+               "ops", "median ns", "min ns", "max ns", "mad %");
+}
+
+void Bench::_report(const std::string &name, u64 ops,
+                    const std::vector<u64> &times) {
+    ASSERT_RET_V(!times.empty() && ops > 0);
+
+    std::vector<f64> per_op;
+    per_op.reserve(times.size());
+    for (const u64 time : times) {
+        per_op.push_back(static_cast<f64>(time) / static_cast<f64>(ops));
+    }
+    const f64 middle{median(per_op)};
+    const auto [min, max]{std::minmax_element(per_op.begin(), per_op.end())};
+
+    std::vector<f64> deviations;
+    deviations.reserve(per_op.size());
+    for (const f64 value : per_op) {
+        deviations.push_back(std::abs(value - middle));
+    }
+    const f64 spread{middle > 0.0 ? median(deviations) / middle * 100.0
+                                  : 0.0};
+
+    fmt::print("{:<36} {:>10} {:>12.2f} {:>12.2f} {:>12.2f} {:>7.2f}\n", name,
+               ops, middle, *min, *max, spread);
+}
+
+}  // namespace explore::bench
@@ -0,0 +1,86 @@
+#ifndef EXPLORE_BENCH_BENCH_H_
+#define EXPLORE_BENCH_BENCH_H_
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../src/common.h"
+#include "../src/core/profiler.h"
+
+namespace explore::bench {
+struct BenchOptions {
+    // untimed runs before measuring, to fill caches and grow containers
+    u32 warmup{3};
+    // timed runs, the result is their median
+    u32 repetitions{15};
+    // only benchmarks whose name contains this run
+    std::string filter;
+};
+
+// runs benchmarks with warm-up and repetitions and prints them as a table.
+// every run times only its body, setup and teardown are left out so each
+// repetition starts from the same state
+class Bench {
+   public:
+    explicit Bench(BenchOptions options) : _options(std::move(options)) {}
+
+    // body runs ops operations per repetition
+    template <typename TSetup, typename TBody, typename TTeardown>
+    void run(const std::string &name, u64 ops, TSetup &&setup, TBody &&body,
+             TTeardown &&teardown);
+
+    // a benchmark without per repetition state
+    template <typename TBody>
+    void run(const std::string &name, u64 ops, TBody &&body) {
+        run(name, ops, [] {}, body, [] {});
+    }
+
+    void print_header() const;
+
+   private:
+    BenchOptions _options;
+
+   private:
+    // prints the median, min and max time per operation and the median
+    // absolute deviation relative to the median
+    void _report(const std::string &name, u64 ops,
+                 const std::vector<u64> &times);
+};
+
+// keeps the compiler from dropping a computed value
+template <typename T>
+inline void do_not_optimize(const T &value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const T *sink;
+    sink = &value;
+#endif
+}
+
+template <typename TSetup, typename TBody, typename TTeardown>
+void Bench::run(const std::string &name, u64 ops, TSetup &&setup,
+                TBody &&body, TTeardown &&teardown) {
+    if (name.find(_options.filter) == std::string::npos) return;
+
+    for (u32 i = 0; i < _options.warmup; ++i) {
+        setup();
+        body();
+        teardown();
+    }
+
+    std::vector<u64> times;
+    times.reserve(_options.repetitions);
+    for (u32 i = 0; i < _options.repetitions; ++i) {
+        setup();
+        const u64 start{core::Profiler::now()};
+        body();
+        times.push_back(core::Profiler::now() - start);
+        teardown();
+    }
+    _report(name, ops, times);
+}
+}  // namespace explore::bench
+
+#endif  // EXPLORE_BENCH_BENCH_H_
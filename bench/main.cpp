@@ -0,0 +1,264 @@
+#include <SDL2/SDL.h>
+#include <spdlog/spdlog.h>
+
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../src/common.h"
+#include "../src/core/texture2d.h"
+#include "../src/core/tilemap.h"
+#include "../src/ecs/components.h"
+#include "../src/ecs/ecs.h"
+#include "../src/events/bus.h"
+#include "../src/events/event.h"
+#include "../src/systems/collision.h"
+#include "../src/systems/movement.h"
+#include "./bench.h"
+
+using namespace explore;
+
+static bench::BenchOptions parse_argv(int argc, char **argv);
+
+// entities with a transform and a rigid body, picked up by Movement
+static std::vector<ecs::Entity> spawn_movers(ecs::Registry &registry, u32 n) {
+    std::vector<ecs::Entity> entities;
+    entities.reserve(n);
+    for (u32 i = 0; i < n; ++i) {
+        ecs::Entity entity{registry.create_entity()};
+        entity.add_component<component::Transform>(
+            glm::vec2(static_cast<f32>(i), 0.f));
+        entity.add_component<component::RigidBody>(glm::vec2(1.f, 1.f));
+        entities.push_back(entity);
+    }
+    registry.update();
+    return entities;
+}
+
+static void bench_ecs(bench::Bench &bench) {
+    for (const u32 n : {1000u, 10000u}) {
+        const std::string suffix{"/" + std::to_string(n)};
+
+        std::unique_ptr<ecs::Registry> registry;
+        const auto fresh_registry{[&] {
+            registry = std::make_unique<ecs::Registry>();
+            registry->add_system<system::Movement>();
+        }};
+        const auto drop_registry{[&] { registry.reset(); }};
+
+        bench.run(
+            "entity create+destroy" + suffix, n, fresh_registry,
+            [&] {
+                for (ecs::Entity &entity : spawn_movers(*registry, n)) {
+                    registry->kill_entity(entity);
+                }
+                registry->update();
+            },
+            drop_registry);
+
+        std::vector<ecs::Entity> entities;
+        bench.run(
+            "add_component" + suffix, n,
+            [&] {
+                fresh_registry();
+                entities.clear();
+                for (u32 i = 0; i < n; ++i) {
+                    entities.push_back(registry->create_entity());
+                }
+            },
+            [&] {
+                for (ecs::Entity &entity : entities) {
+                    entity.add_component<component::Transform>();
+                }
+            },
+            drop_registry);
+
+        fresh_registry();
+        entities = spawn_movers(*registry, n);
+        bench.run("get_component" + suffix, n, [&] {
+            f32 sum{0.f};
+            for (const ecs::Entity &entity : entities) {
+                sum += entity.get_component<component::Transform>().position.x;
+            }
+            bench::do_not_optimize(sum);
+        });
+
+        // the loop every system runs over its entities
+        auto &movement{registry->get_system<system::Movement>()};
+        bench.run("view iteration" + suffix, n, [&] {
+            f32 sum{0.f};
+            for (const ecs::Entity &entity : movement.get_entities()) {
+                const auto &transform{
+                    entity.get_component<component::Transform>()};
+                const auto &body{entity.get_component<component::RigidBody>()};
+                sum += transform.position.x + body.velocity.x;
+            }
+            bench::do_not_optimize(sum);
+        });
+        bench.run("Movement::update" + suffix, n,
+                  [&] { movement.update(1.f / 60.f); });
+        drop_registry();
+    }
+}
+
+static void bench_collision(bench::Bench &bench) {
+    constexpr u32 updates{10};
+    for (const u32 n : {256u, 1024u, 4096u, 16384u}) {
+        ecs::Registry registry;
+        registry.add_system<system::Collision>();
+        auto &collision{registry.get_system<system::Collision>()};
+        collision.set_cell_size(64u);
+        event::Bus bus;
+
+        // the area grows with n so the density, and with it the number of
+        // contacts per entity, stays the same
+        const f32 side{std::sqrt(static_cast<f32>(n)) * 64.f};
+        std::mt19937 rng{1u};
+        std::uniform_real_distribution<f32> position(0.f, side);
+        for (u32 i = 0; i < n; ++i) {
+            ecs::Entity entity{registry.create_entity()};
+            entity.add_component<component::Transform>(
+                glm::vec2(position(rng), position(rng)));
+            entity.add_component<component::BoxCollider>(32u, 32u);
+        }
+        registry.update();
+
+        // timed per entity and update, in the steady state after contacts
+        // were first reported during warm-up
+        bench.run("Collision::update/" + std::to_string(n),
+                  static_cast<u64>(n) * updates, [&] {
+                      for (u32 i = 0; i < updates; ++i) collision.update(bus);
+                  });
+    }
+}
+
+struct BenchEvent : public event::Event {
+    u64 value;
+
+    explicit BenchEvent(u64 value) : value(value) {}
+};
+
+struct BenchHandler {
+    u64 sum{0};
+
+    void on_event(BenchEvent &event) { sum += event.value; }
+};
+
+static void bench_bus(bench::Bench &bench) {
+    constexpr u32 emits{100000};
+    for (const u32 handler_count : {0u, 1u, 4u, 16u}) {
+        event::Bus bus;
+        std::vector<BenchHandler> handlers(handler_count);
+        for (BenchHandler &handler : handlers) {
+            bus.on<BenchEvent>(&handler, &BenchHandler::on_event);
+        }
+
+        bench.run("Bus::emit/" + std::to_string(handler_count) + " handlers",
+                  emits, [&] {
+                      for (u32 i = 0; i < emits; ++i) {
+                          bus.emit<BenchEvent>(static_cast<u64>(i));
+                      }
+                  });
+        for (const BenchHandler &handler : handlers) {
+            bench::do_not_optimize(handler.sum);
+        }
+    }
+}
+
+// writes a map of random tiles in the format Tilemap::load reads
+static std::filesystem::path write_map(u32 size) {
+    const std::filesystem::path path{
+        std::filesystem::temp_directory_path() /
+        ("explore_bench_" + std::to_string(size) + ".map")};
+    std::ofstream file(path);
+    std::mt19937 rng{size};
+    std::uniform_int_distribution<u32> tile(0u, 63u);
+    for (u32 y = 0; y < size; ++y) {
+        for (u32 x = 0; x < size; ++x) {
+            file << (x > 0 ? "," : "") << tile(rng);
+        }
+        file << '\n';
+    }
+    return path;
+}
+
+static void bench_tilemap(bench::Bench &bench) {
+    // the tilemap only needs the width of its tileset, a software renderer
+    // makes the texture without a window
+    SDL_Surface *surface{
+        SDL_CreateRGBSurfaceWithFormat(0, 1, 1, 32, SDL_PIXELFORMAT_ARGB8888)};
+    SDL_Renderer *renderer{
+        surface ? SDL_CreateSoftwareRenderer(surface) : nullptr};
+    if (renderer == nullptr) {
+        spdlog::error("skipping tilemap benchmarks, no renderer {}",
+                      SDL_GetError());
+        if (surface) SDL_FreeSurface(surface);
+        return;
+    }
+
+    {
+        core::Texture2D tileset{"tileset", ""};
+        tileset.initialize_target(renderer, 256u, 256u);
+
+        ecs::Registry registry;
+        core::Tilemap tilemap{registry, "bench", 32u, 32u, 1u};
+        for (const u32 size : {64u, 512u}) {
+            const std::filesystem::path path{write_map(size)};
+            bench.run(
+                "Tilemap::load/" + std::to_string(size) + "x" +
+                    std::to_string(size),
+                static_cast<u64>(size) * size, [] {},
+                [&] { tilemap.load(path, tileset); },
+                [&] {
+                    tilemap.unload();
+                    registry.update();
+                });
+            std::filesystem::remove(path);
+        }
+    }
+
+    SDL_DestroyRenderer(renderer);
+    SDL_FreeSurface(surface);
+}
+
+i32 main(int argc, char **argv) {
+    // engine debug logs would be timed along with the code around them,
+    // results go to stdout
+    spdlog::set_level(spdlog::level::warn);
+
+    bench::Bench bench{parse_argv(argc, argv)};
+    bench.print_header();
+
+    bench_ecs(bench);
+    bench_collision(bench);
+    bench_bus(bench);
+    bench_tilemap(bench);
+
+    return EXIT_SUCCESS;
+}
+
+bench::BenchOptions parse_argv(int argc, char **argv) {
+    bench::BenchOptions options{};
+    for (int i = 0; i < argc; i++) {
+        std::string key{argv[i]};
+
+        if (key == "--warmup" && i + 1 < argc) {
+            options.warmup = std::stoul(argv[i + 1]);
+            i++;
+        }
+        if (key == "--repetitions" && i + 1 < argc) {
+            options.repetitions = std::stoul(argv[i + 1]);
+            i++;
+        }
+        // runs only the benchmarks whose name contains the filter
+        if (key == "--filter" && i + 1 < argc) {
+            options.filter = argv[i + 1];
+            i++;
+        }
+    }
+    return options;
+}
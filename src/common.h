@@ -96,6 +96,12 @@ constexpr f64 FRAME_TARGET{1000.f / FPS};
 /* maximum delta time (useful if running in debugger) */
 constexpr f64 MAXIMUM_DT{0.05f};
 
+/* fixed simulation steps per second, independent of the frame rate */
+constexpr u32 TICK_RATE{60};
+
+/* most simulation steps a single frame may run to catch up */
+constexpr u32 MAX_TICKS_PER_FRAME{5};
+
 // enum Tags { PLAYER_TAG, ENEMY_TAG };
 //
 // enum Groups { ENEMY_GROUP, TILE_GROUP, PROJECTILE_GROUP };
@@ -108,6 +114,21 @@ const std::string PROJECTILE_GROUP{"projectiles"};
 
 }  // namespace explore::constants
 
+/* collision layers, a pair of colliders is only tested when each collider's
+ * layer is part of the other collider's mask */
+namespace explore::layer {
+constexpr u32 NONE{0};
+constexpr u32 DEFAULT{1u << 0};
+constexpr u32 PLAYER{1u << 1};
+constexpr u32 ENEMY{1u << 2};
+constexpr u32 PLAYER_PROJECTILE{1u << 3};
+constexpr u32 ENEMY_PROJECTILE{1u << 4};
+// static tile layers, only ever tested against the tilemap material grid
+constexpr u32 WATER{1u << 5};
+constexpr u32 TERRAIN{1u << 6};
+constexpr u32 ALL{~0u};
+}  // namespace explore::layer
+
 /* collection of sdl colors */
 namespace explore::color {
 constexpr Color white{255, 255, 255, 255};
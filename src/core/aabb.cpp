@@ -0,0 +1,62 @@
+#include "aabb.h"
+
+#include <cmath>
+#include <limits>
+#include <utility>
+
+#include "../ecs/components.h"
+
+namespace explore::core {
+AABB aabb(const component::Transform &t, const component::BoxCollider &c) {
+    const glm::vec2 min{t.position + c.offset};
+    const glm::vec2 size{c.width * t.scale.x, c.height * t.scale.y};
+    return AABB(min, min + size);
+}
+
+AABB aabb(const SDL_Rect &r) {
+    const glm::vec2 min{static_cast<f32>(r.x), static_cast<f32>(r.y)};
+    return AABB(min, min + glm::vec2(static_cast<f32>(r.w),
+                                     static_cast<f32>(r.h)));
+}
+
+bool segment_intersect(const AABB &box, glm::vec2 from, glm::vec2 to,
+                       f32 &fraction) {
+    const glm::vec2 delta{to - from};
+    f32 t_min{0.f};
+    f32 t_max{1.f};
+
+    for (i32 axis = 0; axis < 2; ++axis) {
+        if (std::abs(delta[axis]) < std::numeric_limits<f32>::epsilon()) {
+            // parallel to the slab, must already be inside it
+            if (from[axis] < box.min[axis] || from[axis] >= box.max[axis]) {
+                return false;
+            }
+            continue;
+        }
+
+        const f32 inv{1.f / delta[axis]};
+        f32 t1{(box.min[axis] - from[axis]) * inv};
+        f32 t2{(box.max[axis] - from[axis]) * inv};
+        if (t1 > t2) std::swap(t1, t2);
+
+        t_min = t1 > t_min ? t1 : t_min;
+        t_max = t2 < t_max ? t2 : t_max;
+        if (t_min > t_max) return false;
+    }
+
+    fraction = t_min;
+    return true;
+}
+
+bool swept_intersect(const AABB &a, glm::vec2 da, const AABB &b, glm::vec2 db,
+                     f32 &toi) {
+    if (a.overlaps(b)) {
+        toi = 0.f;
+        return true;
+    }
+    // a against b grown by the size of a reduces the test to a point moving
+    // by the relative displacement
+    const AABB expanded{b.min - a.size(), b.max};
+    return segment_intersect(expanded, a.min, a.min + (da - db), toi);
+}
+}  // namespace explore::core
@@ -0,0 +1,60 @@
+#ifndef EXPLORE_CORE_AABB_H_
+#define EXPLORE_CORE_AABB_H_
+
+#include <SDL_rect.h>
+
+#include "../common.h"
+
+namespace explore::component {
+class Transform;
+class BoxCollider;
+}  // namespace explore::component
+
+namespace explore::core {
+/* axis aligned bounding box in world space, max is exclusive */
+struct AABB {
+    glm::vec2 min;
+    glm::vec2 max;
+
+    AABB(glm::vec2 min = glm::vec2(0), glm::vec2 max = glm::vec2(0))
+        : min(min), max(max) {}
+
+    glm::vec2 size() const { return max - min; }
+
+    f32 perimeter() const { return 2.f * ((max.x - min.x) + (max.y - min.y)); }
+
+    bool overlaps(const AABB &other) const {
+        return min.x < other.max.x && max.x > other.min.x &&
+               min.y < other.max.y && max.y > other.min.y;
+    }
+
+    bool contains(const AABB &other) const {
+        return min.x <= other.min.x && min.y <= other.min.y &&
+               max.x >= other.max.x && max.y >= other.max.y;
+    }
+
+    AABB expanded(f32 margin) const {
+        return AABB(min - glm::vec2(margin), max + glm::vec2(margin));
+    }
+
+    static AABB combine(const AABB &a, const AABB &b) {
+        return AABB(glm::min(a.min, b.min), glm::max(a.max, b.max));
+    }
+};
+
+AABB aabb(const component::Transform &t, const component::BoxCollider &c);
+AABB aabb(const SDL_Rect &r);
+
+// slab test of the segment from->to against box. on a hit, fraction is set to
+// the entry point in [0, 1] along the segment (0 if from starts inside)
+bool segment_intersect(const AABB &box, glm::vec2 from, glm::vec2 to,
+                       f32 &fraction);
+
+// swept test of a moving by da against b moving by db over one step, both
+// given at the start of the step. on a hit, toi is set to the time of impact
+// in [0, 1] (0 if they already overlap)
+bool swept_intersect(const AABB &a, glm::vec2 da, const AABB &b, glm::vec2 db,
+                     f32 &toi);
+}  // namespace explore::core
+
+#endif  // EXPLORE_CORE_AABB_H_
@@ -0,0 +1,285 @@
+#include "aabb_tree.h"
+
+#include <algorithm>
+
+namespace explore::core {
+AABBTree::AABBTree(f32 margin)
+    : _nodes(),
+      _root(null_node),
+      _free_list(null_node),
+      _proxy_count(0),
+      _margin(margin) {}
+
+void AABBTree::clear() {
+    _nodes.clear();
+    _root = null_node;
+    _free_list = null_node;
+    _proxy_count = 0;
+}
+
+i32 AABBTree::create_proxy(const AABB &aabb, u32 user_data) {
+    const i32 proxy{_allocate_node()};
+
+    Node &node{_nodes[proxy]};
+    node.aabb = aabb.expanded(_margin);
+    node.user_data = user_data;
+    node.height = 0;
+
+    _insert_leaf(proxy);
+    ++_proxy_count;
+    return proxy;
+}
+
+void AABBTree::destroy_proxy(i32 proxy) {
+    ASSERT_RET_V(proxy >= 0 && proxy < static_cast<i32>(_nodes.size()));
+    ASSERT_RET_V(_nodes[proxy].is_leaf());
+
+    _remove_leaf(proxy);
+    _free_node(proxy);
+    --_proxy_count;
+}
+
+bool AABBTree::move_proxy(i32 proxy, const AABB &aabb) {
+    ASSERT_RET(proxy >= 0 && proxy < static_cast<i32>(_nodes.size()), false);
+    ASSERT_RET(_nodes[proxy].is_leaf(), false);
+
+    if (_nodes[proxy].aabb.contains(aabb)) {
+        return false;
+    }
+
+    _remove_leaf(proxy);
+    _nodes[proxy].aabb = aabb.expanded(_margin);
+    _insert_leaf(proxy);
+    return true;
+}
+
+u32 AABBTree::get_user_data(i32 proxy) const {
+    return _nodes[proxy].user_data;
+}
+
+const AABB &AABBTree::get_fat_aabb(i32 proxy) const {
+    return _nodes[proxy].aabb;
+}
+
+i32 AABBTree::height() const {
+    return _root == null_node ? 0 : _nodes[_root].height;
+}
+
+i32 AABBTree::_allocate_node() {
+    if (_free_list == null_node) {
+        _nodes.push_back(Node{});
+        _free_list = static_cast<i32>(_nodes.size()) - 1;
+        _nodes[_free_list].parent = null_node;
+    }
+
+    const i32 id{_free_list};
+    Node &node{_nodes[id]};
+    _free_list = node.parent;
+    node.parent = null_node;
+    node.child1 = null_node;
+    node.child2 = null_node;
+    node.height = 0;
+    node.user_data = 0;
+    return id;
+}
+
+void AABBTree::_free_node(i32 node) {
+    _nodes[node].parent = _free_list;
+    _nodes[node].height = -1;
+    _free_list = node;
+}
+
+void AABBTree::_insert_leaf(i32 leaf) {
+    if (_root == null_node) {
+        _root = leaf;
+        _nodes[_root].parent = null_node;
+        return;
+    }
+
+    // find the best sibling by walking down the cheapest surface area path
+    const AABB leaf_aabb{_nodes[leaf].aabb};
+    i32 index{_root};
+    while (!_nodes[index].is_leaf()) {
+        const i32 child1{_nodes[index].child1};
+        const i32 child2{_nodes[index].child2};
+
+        const f32 area{_nodes[index].aabb.perimeter()};
+        const f32 combined_area{
+            AABB::combine(_nodes[index].aabb, leaf_aabb).perimeter()};
+
+        // cost of creating a new parent for this node and the new leaf
+        const f32 cost{2.f * combined_area};
+        // minimum cost of pushing the leaf further down the tree
+        const f32 inheritance_cost{2.f * (combined_area - area)};
+
+        auto descend_cost = [&](i32 child) {
+            const AABB combined{AABB::combine(leaf_aabb, _nodes[child].aabb)};
+            if (_nodes[child].is_leaf()) {
+                return combined.perimeter() + inheritance_cost;
+            }
+            return (combined.perimeter() - _nodes[child].aabb.perimeter()) +
+                   inheritance_cost;
+        };
+
+        const f32 cost1{descend_cost(child1)};
+        const f32 cost2{descend_cost(child2)};
+
+        if (cost < cost1 && cost < cost2) break;
+
+        index = cost1 < cost2 ? child1 : child2;
+    }
+
+    const i32 sibling{index};
+
+    const i32 old_parent{_nodes[sibling].parent};
+    const i32 new_parent{_allocate_node()};
+    _nodes[new_parent].parent = old_parent;
+    _nodes[new_parent].aabb = AABB::combine(leaf_aabb, _nodes[sibling].aabb);
+    _nodes[new_parent].height = _nodes[sibling].height + 1;
+
+    if (old_parent != null_node) {
+        if (_nodes[old_parent].child1 == sibling) {
+            _nodes[old_parent].child1 = new_parent;
+        } else {
+            _nodes[old_parent].child2 = new_parent;
+        }
+    } else {
+        _root = new_parent;
+    }
+    _nodes[new_parent].child1 = sibling;
+    _nodes[new_parent].child2 = leaf;
+    _nodes[sibling].parent = new_parent;
+    _nodes[leaf].parent = new_parent;
+
+    // walk back up fixing heights and boxes
+    index = _nodes[leaf].parent;
+    while (index != null_node) {
+        index = _balance(index);
+
+        const i32 child1{_nodes[index].child1};
+        const i32 child2{_nodes[index].child2};
+
+        _nodes[index].height =
+            1 + std::max(_nodes[child1].height, _nodes[child2].height);
+        _nodes[index].aabb =
+            AABB::combine(_nodes[child1].aabb, _nodes[child2].aabb);
+
+        index = _nodes[index].parent;
+    }
+}
+
+void AABBTree::_remove_leaf(i32 leaf) {
+    if (leaf == _root) {
+        _root = null_node;
+        return;
+    }
+
+    const i32 parent{_nodes[leaf].parent};
+    const i32 grand_parent{_nodes[parent].parent};
+    const i32 sibling{_nodes[parent].child1 == leaf ? _nodes[parent].child2
+                                                    : _nodes[parent].child1};
+
+    if (grand_parent != null_node) {
+        // destroy parent and connect sibling to grand parent
+        if (_nodes[grand_parent].child1 == parent) {
+            _nodes[grand_parent].child1 = sibling;
+        } else {
+            _nodes[grand_parent].child2 = sibling;
+        }
+        _nodes[sibling].parent = grand_parent;
+        _free_node(parent);
+
+        i32 index{grand_parent};
+        while (index != null_node) {
+            index = _balance(index);
+
+            const i32 child1{_nodes[index].child1};
+            const i32 child2{_nodes[index].child2};
+
+            _nodes[index].aabb =
+                AABB::combine(_nodes[child1].aabb, _nodes[child2].aabb);
+            _nodes[index].height =
+                1 + std::max(_nodes[child1].height, _nodes[child2].height);
+
+            index = _nodes[index].parent;
+        }
+    } else {
+        _root = sibling;
+        _nodes[sibling].parent = null_node;
+        _free_node(parent);
+    }
+}
+
+// performs a left or right rotation if node a is imbalanced, returns the new
+// root of the subtree
+i32 AABBTree::_balance(i32 a) {
+    Node &node_a{_nodes[a]};
+    if (node_a.is_leaf() || node_a.height < 2) {
+        return a;
+    }
+
+    const i32 b{node_a.child1};
+    const i32 c{node_a.child2};
+
+    const i32 balance{_nodes[c].height - _nodes[b].height};
+
+    // rotates the higher child up, lower is the child staying below a
+    auto rotate = [&](i32 higher, i32 lower) {
+        const i32 f{_nodes[higher].child1};
+        const i32 g{_nodes[higher].child2};
+
+        // swap a and higher
+        _nodes[higher].child1 = a;
+        _nodes[higher].parent = _nodes[a].parent;
+        _nodes[a].parent = higher;
+
+        // a's old parent should point to higher
+        const i32 parent{_nodes[higher].parent};
+        if (parent != null_node) {
+            if (_nodes[parent].child1 == a) {
+                _nodes[parent].child1 = higher;
+            } else {
+                _nodes[parent].child2 = higher;
+            }
+        } else {
+            _root = higher;
+        }
+
+        // keep the taller grandchild under higher, hand the other one to a
+        const bool keep_f{_nodes[f].height > _nodes[g].height};
+        const i32 kept{keep_f ? f : g};
+        const i32 moved{keep_f ? g : f};
+
+        _nodes[higher].child2 = kept;
+        if (_nodes[a].child1 == higher) {
+            _nodes[a].child1 = moved;
+        } else {
+            _nodes[a].child2 = moved;
+        }
+        _nodes[moved].parent = a;
+
+        _nodes[a].aabb =
+            AABB::combine(_nodes[lower].aabb, _nodes[moved].aabb);
+        _nodes[higher].aabb =
+            AABB::combine(_nodes[a].aabb, _nodes[kept].aabb);
+
+        _nodes[a].height =
+            1 + std::max(_nodes[lower].height, _nodes[moved].height);
+        _nodes[higher].height =
+            1 + std::max(_nodes[a].height, _nodes[kept].height);
+    };
+
+    if (balance > 1) {
+        rotate(c, b);
+        return c;
+    }
+
+    if (balance < -1) {
+        rotate(b, c);
+        return b;
+    }
+
+    return a;
+}
+
+}  // namespace explore::core
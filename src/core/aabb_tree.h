@@ -0,0 +1,159 @@
+#ifndef EXPLORE_CORE_AABB_TREE_H_
+#define EXPLORE_CORE_AABB_TREE_H_
+
+#include <array>
+#include <vector>
+
+#include "../common.h"
+#include "./aabb.h"
+
+namespace explore::core {
+// dynamic bounding volume hierarchy. leaves store a fattened copy of the box
+// they were inserted with, so small movements do not touch the tree at all.
+// the tree is kept balanced with rotations, queries are O(log n) + hits
+class AABBTree {
+   public:
+    static constexpr i32 null_node{-1};
+
+    explicit AABBTree(f32 margin = 8.f);
+
+    // inserts box and returns a proxy id that stays valid until destroyed
+    i32 create_proxy(const AABB &aabb, u32 user_data);
+    void destroy_proxy(i32 proxy);
+
+    // refits the proxy to aabb. the leaf is only reinserted when aabb has
+    // left its fattened box, returns true if that happened
+    bool move_proxy(i32 proxy, const AABB &aabb);
+
+    u32 get_user_data(i32 proxy) const;
+    const AABB &get_fat_aabb(i32 proxy) const;
+
+    u32 proxy_count() const { return _proxy_count; }
+    i32 height() const;
+
+    void clear();
+
+    // calls fn(user_data) for every proxy whose fat box overlaps aabb. fn
+    // returns false to stop the query early
+    template <typename TFn>
+    void query(const AABB &aabb, TFn &&fn) const;
+
+    // walks the proxies whose fat box is crossed by the segment from->to.
+    // fn(user_data, max_fraction) returns the new max fraction: 0 stops the
+    // cast, the current value ignores the proxy and a smaller value clips it
+    template <typename TFn>
+    void raycast(glm::vec2 from, glm::vec2 to, TFn &&fn) const;
+
+   private:
+    struct Node {
+        AABB aabb;
+        // parent for nodes in the tree, next free node for pooled nodes
+        i32 parent;
+        i32 child1;
+        i32 child2;
+        // leaf is 0, free node is -1
+        i32 height;
+        u32 user_data;
+
+        bool is_leaf() const { return child1 == null_node; }
+    };
+
+    std::vector<Node> _nodes;
+    i32 _root;
+    i32 _free_list;
+    u32 _proxy_count;
+    f32 _margin;
+
+   private:
+    // traversal stack owned by a single query, so const queries can run
+    // from several threads at once. a balanced tree never gets near the
+    // inline size, deeper ones spill to the heap
+    class Stack {
+       public:
+        Stack() : _inline(), _spill(), _size(0) {}
+
+        bool empty() const { return _size == 0; }
+
+        void push(i32 id) {
+            if (_size < _inline.size()) {
+                _inline[_size] = id;
+            } else {
+                _spill.push_back(id);
+            }
+            ++_size;
+        }
+
+        i32 pop() {
+            --_size;
+            if (_size < _inline.size()) return _inline[_size];
+            const i32 id{_spill.back()};
+            _spill.pop_back();
+            return id;
+        }
+
+       private:
+        std::array<i32, 64> _inline;
+        std::vector<i32> _spill;
+        u32 _size;
+    };
+
+   private:
+    i32 _allocate_node();
+    void _free_node(i32 node);
+    void _insert_leaf(i32 leaf);
+    void _remove_leaf(i32 leaf);
+    i32 _balance(i32 node);
+};
+
+template <typename TFn>
+void AABBTree::query(const AABB &aabb, TFn &&fn) const {
+    if (_root == null_node) return;
+
+    Stack stack{};
+    stack.push(_root);
+    while (!stack.empty()) {
+        const i32 id{stack.pop()};
+
+        const Node &node{_nodes[id]};
+        if (!node.aabb.overlaps(aabb)) continue;
+
+        if (node.is_leaf()) {
+            if (!fn(node.user_data)) return;
+        } else {
+            stack.push(node.child1);
+            stack.push(node.child2);
+        }
+    }
+}
+
+template <typename TFn>
+void AABBTree::raycast(glm::vec2 from, glm::vec2 to, TFn &&fn) const {
+    if (_root == null_node) return;
+
+    f32 max_fraction{1.f};
+
+    Stack stack{};
+    stack.push(_root);
+    while (!stack.empty()) {
+        const i32 id{stack.pop()};
+
+        const Node &node{_nodes[id]};
+        // clip the segment so boxes behind the closest hit are skipped
+        const glm::vec2 end{from + (to - from) * max_fraction};
+        f32 fraction{0.f};
+        if (!segment_intersect(node.aabb, from, end, fraction)) continue;
+
+        if (node.is_leaf()) {
+            const f32 value{fn(node.user_data, max_fraction)};
+            if (value <= 0.f) return;
+            max_fraction = value;
+        } else {
+            stack.push(node.child1);
+            stack.push(node.child2);
+        }
+    }
+}
+
+}  // namespace explore::core
+
+#endif  // EXPLORE_CORE_AABB_TREE_H_
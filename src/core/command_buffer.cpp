@@ -0,0 +1,41 @@
+#include "command_buffer.h"
+
+namespace explore::core {
+void CommandBuffer::clear() {
+    _keys.clear();
+    _commands.clear();
+}
+
+void CommandBuffer::push(u64 key, const DrawCommand &command) {
+    _keys.push_back({key, static_cast<u32>(_commands.size())});
+    _commands.push_back(command);
+}
+
+void CommandBuffer::sort() {
+    const u32 count{size()};
+    if (count < 2) return;
+    _scratch.resize(count);
+
+    // one counting pass per byte, least significant first
+    for (u32 shift = 0; shift < 64; shift += 8) {
+        u32 counts[256]{};
+        for (const Key &key : _keys) ++counts[(key.key >> shift) & 0xff];
+
+        // every key shares this byte, the pass would not move anything
+        if (counts[(_keys[0].key >> shift) & 0xff] == count) continue;
+
+        u32 offset{0};
+        for (u32 &bucket : counts) {
+            const u32 bucket_count{bucket};
+            bucket = offset;
+            offset += bucket_count;
+        }
+
+        for (const Key &key : _keys) {
+            _scratch[counts[(key.key >> shift) & 0xff]++] = key;
+        }
+        _keys.swap(_scratch);
+    }
+}
+
+}  // namespace explore::core
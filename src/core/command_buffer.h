@@ -0,0 +1,70 @@
+#ifndef EXPLORE_CORE_COMMAND_BUFFER_H_
+#define EXPLORE_CORE_COMMAND_BUFFER_H_
+
+#include <SDL_rect.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "../common.h"
+
+namespace explore::core {
+class Texture2D;
+
+// one textured quad, src addresses the original image of texture
+struct DrawCommand {
+    const Texture2D *texture;
+    SDL_Rect src;
+    SDL_Rect dst;
+    f64 angle;
+};
+
+// draw commands of one frame ordered by packed 64 bit keys. keys are sorted
+// with an lsd radix sort, which is stable, so equal keys keep push order
+class CommandBuffer {
+   public:
+    // largest layer a key holds
+    static constexpr u32 max_layer{0xffffu};
+
+    // layer in the top 16 bits, texture handle in the next 16 and depth in
+    // the low 32, so commands group by layer first and texture second.
+    // layers over max_layer are clamped, masking would sort them under 0
+    static u64 make_key(u32 layer, u32 texture, u32 depth) {
+        return (static_cast<u64>(std::min(layer, max_layer)) << 48) |
+               (static_cast<u64>(texture & 0xffffu) << 32) | depth;
+    }
+
+    static u32 key_layer(u64 key) { return static_cast<u32>(key >> 48); }
+    static u32 key_texture(u64 key) {
+        return static_cast<u32>(key >> 32) & 0xffffu;
+    }
+
+    u32 size() const { return static_cast<u32>(_keys.size()); }
+    bool empty() const { return _keys.empty(); }
+
+    void clear();
+
+    void push(u64 key, const DrawCommand &command);
+
+    // orders the commands by key, call once after all pushes
+    void sort();
+
+    // key and command at position i of the sorted order
+    u64 key(u32 i) const { return _keys[i].key; }
+    const DrawCommand &command(u32 i) const {
+        return _commands[_keys[i].command];
+    }
+
+   private:
+    struct Key {
+        u64 key;
+        u32 command;
+    };
+
+    std::vector<Key> _keys;
+    std::vector<Key> _scratch;
+    std::vector<DrawCommand> _commands;
+};
+}  // namespace explore::core
+
+#endif  // EXPLORE_CORE_COMMAND_BUFFER_H_
@@ -0,0 +1,116 @@
+#include "contact_cache.h"
+
+namespace explore::core {
+ContactCache::ContactCache(u32 capacity)
+    : _slots(), _contacts(), _links(), _frame(0) {
+    // capacity is kept a power of two so the home slot is a mask away
+    u32 slots{16u};
+    while (slots < capacity * 2) slots <<= 1;
+    _slots.assign(slots, Slot{_empty_key, 0});
+}
+
+bool ContactCache::touch(u32 a, u32 b) {
+    const u64 key{_key(a, b)};
+    u32 slot{_find(key)};
+    if (_slots[slot].key == key) {
+        _contacts[_slots[slot].contact].frame = _frame;
+        return false;
+    }
+
+    // keep the load factor at or below one half
+    if ((_contacts.size() + 1) * 2 > _slots.size()) {
+        _grow();
+        slot = _find(key);
+    }
+
+    _slots[slot] = {key, static_cast<u32>(_contacts.size())};
+    _contacts.push_back({key, _frame});
+    _link(static_cast<u32>(key >> 32), key);
+    _link(static_cast<u32>(key), key);
+    return true;
+}
+
+void ContactCache::remove(u32 id) {
+    if (id >= _links.size()) return;
+
+    // _erase unlinks the key from both ids, so this list shrinks every step
+    while (!_links[id].empty()) {
+        _erase(_slots[_find(_links[id].back())].contact);
+    }
+}
+
+void ContactCache::clear() {
+    for (auto &slot : _slots) slot.key = _empty_key;
+    _contacts.clear();
+    for (auto &links : _links) links.clear();
+}
+
+u32 ContactCache::_home(u64 key) const {
+    // fibonacci hashing spreads the packed ids over the table
+    const u64 hash{key * 11400714819323198485ull};
+    return static_cast<u32>(hash >> 32) & (static_cast<u32>(_slots.size()) - 1);
+}
+
+u32 ContactCache::_find(u64 key) const {
+    const u32 mask{static_cast<u32>(_slots.size()) - 1};
+    u32 slot{_home(key)};
+    while (_slots[slot].key != key && _slots[slot].key != _empty_key) {
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+void ContactCache::_grow() {
+    _slots.assign(_slots.size() * 2, Slot{_empty_key, 0});
+    for (u32 i = 0; i < size(); ++i) {
+        _slots[_find(_contacts[i].key)] = {_contacts[i].key, i};
+    }
+}
+
+void ContactCache::_link(u32 id, u64 key) {
+    if (id >= _links.size()) _links.resize(id + 1);
+    _links[id].push_back(key);
+}
+
+void ContactCache::_unlink(u32 id, u64 key) {
+    auto &links{_links[id]};
+    for (u32 i = 0; i < links.size(); ++i) {
+        if (links[i] != key) continue;
+        links[i] = links.back();
+        links.pop_back();
+        return;
+    }
+}
+
+void ContactCache::_erase(u32 contact) {
+    const u32 mask{static_cast<u32>(_slots.size()) - 1};
+    const u64 key{_contacts[contact].key};
+    _unlink(static_cast<u32>(key >> 32), key);
+    _unlink(static_cast<u32>(key), key);
+
+    // backward shift deletion keeps probe chains intact without tombstones
+    u32 hole{_find(_contacts[contact].key)};
+    u32 next{(hole + 1) & mask};
+    while (_slots[next].key != _empty_key) {
+        const u32 home{_home(_slots[next].key)};
+        // move next into the hole unless its home lies in (hole, next]
+        const bool in_place{hole <= next ? (hole < home && home <= next)
+                                         : (hole < home || home <= next)};
+        if (!in_place) {
+            _slots[hole] = _slots[next];
+            hole = next;
+        }
+        next = (next + 1) & mask;
+    }
+    _slots[hole].key = _empty_key;
+
+    // swap-remove from the dense list and repoint the moved contact's slot
+    const u32 last{size() - 1};
+    if (contact != last) {
+        _contacts[contact] = _contacts[last];
+        _slots[_find(_contacts[contact].key)].contact = contact;
+    }
+    _contacts.pop_back();
+}
+
+}  // namespace explore::core
@@ -0,0 +1,85 @@
+#ifndef EXPLORE_CORE_CONTACT_CACHE_H_
+#define EXPLORE_CORE_CONTACT_CACHE_H_
+
+#include <vector>
+
+#include "../common.h"
+
+namespace explore::core {
+// set of entity pairs currently in contact. pairs live in a flat open
+// addressing table (linear probing, backward shift deletion) that points into
+// a dense contact list, so finding stale contacts only walks live contacts.
+// each id also lists the pairs it is in, so removing an entity only walks
+// its own contacts
+class ContactCache {
+   public:
+    explicit ContactCache(u32 capacity = 256u);
+
+    u32 size() const { return static_cast<u32>(_contacts.size()); }
+
+    // starts a new frame, contacts not touched until the next sweep are stale
+    void begin_frame() { ++_frame; }
+
+    // marks the pair as touching this frame, returns true for a new contact
+    bool touch(u32 a, u32 b);
+
+    // calls fn(a, b) for every contact that was not touched this frame and
+    // removes it, a is always the lower id
+    template <typename TFn>
+    void sweep(TFn &&fn);
+
+    // drops every contact involving id without reporting it, linear in the
+    // contacts of id
+    void remove(u32 id);
+
+    void clear();
+
+   private:
+    static constexpr u64 _empty_key{~0ull};
+
+    struct Slot {
+        u64 key;
+        u32 contact;
+    };
+
+    struct Contact {
+        u64 key;
+        u32 frame;
+    };
+
+    std::vector<Slot> _slots;
+    std::vector<Contact> _contacts;
+    // keys of the contacts each id takes part in, indexed by id
+    std::vector<std::vector<u64>> _links;
+    u32 _frame;
+
+   private:
+    static u64 _key(u32 a, u32 b) {
+        return a < b ? (static_cast<u64>(a) << 32) | b
+                     : (static_cast<u64>(b) << 32) | a;
+    }
+
+    u32 _home(u64 key) const;
+    // slot holding key, or the empty slot where it would be inserted
+    u32 _find(u64 key) const;
+    void _grow();
+    void _link(u32 id, u64 key);
+    void _unlink(u32 id, u64 key);
+    void _erase(u32 contact);
+};
+
+template <typename TFn>
+void ContactCache::sweep(TFn &&fn) {
+    // walk backwards so swap-removal never skips a contact
+    for (u32 i = size(); i-- > 0;) {
+        if (_contacts[i].frame == _frame) continue;
+
+        const u64 key{_contacts[i].key};
+        _erase(i);
+        fn(static_cast<u32>(key >> 32), static_cast<u32>(key));
+    }
+}
+
+}  // namespace explore::core
+
+#endif  // EXPLORE_CORE_CONTACT_CACHE_H_
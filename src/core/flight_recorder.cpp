@@ -0,0 +1,158 @@
+#include "flight_recorder.h"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <string>
+
+namespace explore::core {
+
+static thread_local i32 attached_track{-1};
+
+static const char *track_name(u32 track) {
+    switch (static_cast<FlightRecorder::Track>(track)) {
+        case FlightRecorder::Track::Simulation:
+            return "simulation";
+        case FlightRecorder::Track::Render:
+            return "render";
+        default:
+            return "unknown";
+    }
+}
+
+FlightRecorder::FlightRecorder()
+    : _threshold(0.0),
+      _directory(),
+      _tracks(),
+      _frames(frame_capacity),
+      _frame_count(0),
+      _last_dump(0),
+      _dumps(0),
+      _writer() {
+    for (auto &track : _tracks) {
+        track.scopes.resize(scope_capacity);
+        track.count = 0;
+    }
+}
+
+FlightRecorder::~FlightRecorder() {
+    if (_writer.joinable()) _writer.join();
+}
+
+void FlightRecorder::configure(f64 threshold,
+                               const std::filesystem::path &directory) {
+    _threshold = threshold;
+    _directory = directory;
+    if (_threshold > 0.0) {
+        spdlog::info("dumping frames over {:.1f}ms into {}", _threshold,
+                     _directory.string());
+    }
+}
+
+void FlightRecorder::attach_thread(Track track) {
+    attached_track = static_cast<i32>(track);
+}
+
+void FlightRecorder::record(const char *name, u64 start, u64 end) {
+    if (attached_track < 0) return;
+
+    ScopeRing &track{_tracks[attached_track]};
+    std::lock_guard<std::mutex> lock(track.mutex);
+    track.scopes[track.count % scope_capacity] = {name, start, end};
+    ++track.count;
+}
+
+void FlightRecorder::end_frame(const Frame &frame) {
+    _frames[_frame_count % frame_capacity] = frame;
+    const u64 index{_frame_count++};
+
+    if (_threshold <= 0.0) return;
+    const f64 ms{static_cast<f64>(frame.end - frame.start) / 1000000.0};
+    if (ms <= _threshold) return;
+    if (_dumps > 0 && index - _last_dump < frame_capacity) return;
+
+    spdlog::warn("frame {} took {:.2f}ms, dumping flight recorder", index,
+                 ms);
+    _last_dump = index;
+    _dump(index);
+}
+
+void FlightRecorder::_dump(u64 hitch_frame) {
+    // a dump still being written is waited on rather than dropped
+    if (_writer.joinable()) _writer.join();
+
+    // the recording is copied so the writer never holds a track
+    const u64 frames{std::min<u64>(_frame_count, frame_capacity)};
+    std::vector<Frame> frame_copy;
+    frame_copy.reserve(frames);
+    for (u64 i = _frame_count - frames; i < _frame_count; ++i) {
+        frame_copy.push_back(_frames[i % frame_capacity]);
+    }
+    const u64 since{frame_copy.front().start};
+
+    std::vector<std::vector<Scope>> scope_copy(_tracks.size());
+    for (u32 t = 0; t < _tracks.size(); ++t) {
+        ScopeRing &track{_tracks[t]};
+        std::lock_guard<std::mutex> lock(track.mutex);
+        const u64 kept{std::min<u64>(track.count, scope_capacity)};
+        for (u64 i = track.count - kept; i < track.count; ++i) {
+            const Scope &scope{track.scopes[i % scope_capacity]};
+            if (scope.start >= since) scope_copy[t].push_back(scope);
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories(_directory, error);
+    const std::filesystem::path path{
+        _directory / ("hitch-" + std::to_string(hitch_frame) + ".json")};
+    ++_dumps;
+
+    _writer = std::thread([path, since, frames = std::move(frame_copy),
+                           scopes = std::move(scope_copy)] {
+        std::ofstream file(path);
+        ASSERT_RET_V_MSG(file.is_open(), "failed to open '%s'",
+                         path.string().c_str());
+
+        // times are written in microseconds since the oldest frame
+        auto us{[since](u64 ns) {
+            return static_cast<f64>(ns - since) / 1000.0;
+        }};
+        file << std::fixed << std::setprecision(3) << "{\"traceEvents\":[";
+        for (u32 t = 0; t < scopes.size(); ++t) {
+            file << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,"
+                 << "\"tid\":" << t << ",\"args\":{\"name\":\""
+                 << track_name(t) << "\"}},";
+            for (const Scope &scope : scopes[t]) {
+                file << "\n{\"name\":\"" << scope.name
+                     << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << t
+                     << ",\"ts\":" << us(scope.start)
+                     << ",\"dur\":" << us(scope.end) - us(scope.start)
+                     << "},";
+            }
+        }
+
+        // frames on a track of their own, counters as counter events
+        const u32 frame_tid{static_cast<u32>(scopes.size())};
+        file << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,"
+             << "\"tid\":" << frame_tid << ",\"args\":{\"name\":\"frames\"}}";
+        for (const Frame &frame : frames) {
+            file << ",\n{\"name\":\"frame\",\"ph\":\"X\",\"pid\":1,\"tid\":"
+                 << frame_tid << ",\"ts\":" << us(frame.start)
+                 << ",\"dur\":" << us(frame.end) - us(frame.start) << "}"
+                 << ",\n{\"name\":\"entities\",\"ph\":\"C\",\"pid\":1,"
+                 << "\"ts\":" << us(frame.start)
+                 << ",\"args\":{\"live\":" << frame.entities
+                 << ",\"created\":" << frame.created
+                 << ",\"destroyed\":" << frame.destroyed << "}}"
+                 << ",\n{\"name\":\"events\",\"ph\":\"C\",\"pid\":1,"
+                 << "\"ts\":" << us(frame.start)
+                 << ",\"args\":{\"emitted\":" << frame.events << "}}";
+        }
+        file << "\n]}\n";
+        spdlog::info("wrote flight recording to {}", path.string());
+    });
+}
+
+}  // namespace explore::core
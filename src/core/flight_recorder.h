@@ -0,0 +1,106 @@
+#ifndef EXPLORE_CORE_FLIGHT_RECORDER_H_
+#define EXPLORE_CORE_FLIGHT_RECORDER_H_
+
+#include <array>
+#include <filesystem>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../common.h"
+#include "./profiler.h"
+
+namespace explore::core {
+// always on recorder of the last few seconds of scope timings and per frame
+// counters. when a frame takes longer than the threshold the recording is
+// copied out and written as a chrome trace_event json file on a background
+// thread, so the hitch is not made worse by the write. every thread records
+// into its own track, guarded by a mutex that is only contended while a dump
+// copies it
+class FlightRecorder {
+   public:
+    enum class Track : u32 { Simulation, Render, Count };
+
+    // scope timings kept per track and frames kept in total
+    static constexpr u32 scope_capacity{1u << 14};
+    static constexpr u32 frame_capacity{1u << 9};
+
+    // per frame counters, recorded by the simulation
+    struct Frame {
+        u64 start;
+        u64 end;
+        u32 entities;
+        u32 created;
+        u32 destroyed;
+        u32 events;
+    };
+
+    FlightRecorder();
+    ~FlightRecorder();
+
+    FlightRecorder(const FlightRecorder &) = delete;
+    FlightRecorder &operator=(const FlightRecorder &) = delete;
+
+    // frames longer than threshold ms are dumped into directory, zero turns
+    // the dumps off while recording continues
+    void configure(f64 threshold, const std::filesystem::path &directory);
+
+    // binds the calling thread to track, scopes it records go there
+    static void attach_thread(Track track);
+
+    // name must be a literal, times from Profiler::now()
+    void record(const char *name, u64 start, u64 end);
+
+    // closes a frame, dumping the recording if it was too long. frames
+    // right after a dump do not trigger another until the ring turned over
+    void end_frame(const Frame &frame);
+
+   private:
+    struct Scope {
+        const char *name;
+        u64 start;
+        u64 end;
+    };
+
+    // rings are allocated once, on the heap as they are large
+    struct ScopeRing {
+        std::mutex mutex;
+        std::vector<Scope> scopes;
+        u64 count;
+    };
+
+    f64 _threshold;
+    std::filesystem::path _directory;
+
+    std::array<ScopeRing, static_cast<u32>(Track::Count)> _tracks;
+    // only touched by the simulation
+    std::vector<Frame> _frames;
+    u64 _frame_count;
+    u64 _last_dump;
+    u32 _dumps;
+
+    std::thread _writer;
+
+   private:
+    void _dump(u64 hitch_frame);
+};
+
+// records the time between construction and destruction
+class RecorderScope {
+   public:
+    RecorderScope(FlightRecorder &recorder, const char *name)
+        : _recorder(recorder), _name(name), _start(Profiler::now()) {}
+
+    ~RecorderScope() { _recorder.record(_name, _start, Profiler::now()); }
+
+    RecorderScope(const RecorderScope &) = delete;
+    RecorderScope &operator=(const RecorderScope &) = delete;
+
+   private:
+    FlightRecorder &_recorder;
+    const char *_name;
+    u64 _start;
+};
+}  // namespace explore::core
+
+#endif  // EXPLORE_CORE_FLIGHT_RECORDER_H_
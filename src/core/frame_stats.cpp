@@ -0,0 +1,119 @@
+#include "frame_stats.h"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+
+namespace explore::core {
+
+static constexpr f64 ns_per_ms{1000000.0};
+
+TimingSeries::TimingSeries(const char *name, u32 window_size)
+    : _name(name), _total(), _window(), _recent(window_size, 0), _next(0) {}
+
+void TimingSeries::record(f64 ms) {
+    const u64 ns{static_cast<u64>(std::max(0.0, ms) * ns_per_ms)};
+    _total.record(ns);
+
+    // once the ring is full the sample it overwrites leaves the window
+    if (_window.count() == _recent.size()) _window.remove(_recent[_next]);
+    _window.record(ns);
+    _recent[_next] = ns;
+    _next = (_next + 1) % static_cast<u32>(_recent.size());
+}
+
+TimingSummary TimingSeries::summarize(const Histogram &histogram) {
+    return {histogram.count(),
+            histogram.mean() / ns_per_ms,
+            histogram.percentile(50.0) / ns_per_ms,
+            histogram.percentile(95.0) / ns_per_ms,
+            histogram.percentile(99.0) / ns_per_ms,
+            histogram.max() / ns_per_ms};
+}
+
+FrameStats::FrameStats(u32 window_size)
+    : _window_size(std::max(window_size, 1u)),
+      _frame("frame", _window_size),
+      _systems() {}
+
+void FrameStats::record_frame(f64 ms) { _frame.record(ms); }
+
+void FrameStats::record(const char *name, f64 ms) {
+    auto series{std::find_if(
+        _systems.begin(), _systems.end(),
+        [name](const TimingSeries &s) { return s.name() == name; })};
+    if (series == _systems.end()) {
+        _systems.emplace_back(name, _window_size);
+        series = std::prev(_systems.end());
+    }
+    series->record(ms);
+}
+
+bool FrameStats::write(const std::filesystem::path &path) const {
+    const bool written{path.extension() == ".json" ? _write_json(path)
+                                                   : _write_csv(path)};
+    if (written) spdlog::info("wrote frame stats to {}", path.string());
+    return written;
+}
+
+bool FrameStats::_write_csv(const std::filesystem::path &path) const {
+    std::ofstream file(path);
+    ASSERT_RET_MSG(file.is_open(), false, "failed to open '%s'",
+                   path.string().c_str());
+
+    // one row per series over the whole run, times in ms
+    file << "name,count,mean,p50,p95,p99,max\n" << std::fixed
+         << std::setprecision(4);
+    auto row{[&](const TimingSeries &series) {
+        const TimingSummary s{TimingSeries::summarize(series.total())};
+        file << series.name() << ',' << s.count << ',' << s.mean << ','
+             << s.p50 << ',' << s.p95 << ',' << s.p99 << ',' << s.max << '\n';
+    }};
+    row(_frame);
+    for (const TimingSeries &series : _systems) row(series);
+    return true;
+}
+
+bool FrameStats::_write_json(const std::filesystem::path &path) const {
+    std::ofstream file(path);
+    ASSERT_RET_MSG(file.is_open(), false, "failed to open '%s'",
+                   path.string().c_str());
+
+    // summaries of the whole run and the last window, and the non empty
+    // buckets of the whole run as [lowest, highest, count], times in ms
+    file << std::fixed << std::setprecision(4) << "{\"series\":[";
+    auto summary{[&](const char *key, const Histogram &histogram) {
+        const TimingSummary s{TimingSeries::summarize(histogram)};
+        file << '"' << key << "\":{\"count\":" << s.count
+             << ",\"mean\":" << s.mean << ",\"p50\":" << s.p50
+             << ",\"p95\":" << s.p95 << ",\"p99\":" << s.p99
+             << ",\"max\":" << s.max << '}';
+    }};
+    auto series{[&](const TimingSeries &timing) {
+        file << "\n{\"name\":\"" << timing.name() << "\",";
+        summary("total", timing.total());
+        file << ',';
+        summary("window", timing.window());
+        file << ",\"histogram\":[";
+        bool first{true};
+        timing.total().for_each_bucket([&](u64 lowest, u64 highest,
+                                           u32 count) {
+            file << (first ? "" : ",") << '[' << lowest / ns_per_ms << ','
+                 << highest / ns_per_ms << ',' << count << ']';
+            first = false;
+        });
+        file << "]}";
+    }};
+
+    series(_frame);
+    for (const TimingSeries &timing : _systems) {
+        file << ',';
+        series(timing);
+    }
+    file << "\n]}\n";
+    return true;
+}
+
+}  // namespace explore::core
@@ -0,0 +1,74 @@
+#ifndef EXPLORE_CORE_FRAME_STATS_H_
+#define EXPLORE_CORE_FRAME_STATS_H_
+
+#include <filesystem>
+#include <vector>
+
+#include "../common.h"
+#include "./histogram.h"
+
+namespace explore::core {
+// percentiles of a series in ms
+struct TimingSummary {
+    u64 count;
+    f64 mean;
+    f64 p50;
+    f64 p95;
+    f64 p99;
+    f64 max;
+};
+
+// durations of one timed thing, over the whole run and over a rolling window
+// of its most recent samples. the window keeps the raw samples in a ring so
+// the oldest can be taken back out of its histogram
+class TimingSeries {
+   public:
+    TimingSeries(const char *name, u32 window_size);
+
+    const char *name() const { return _name; }
+
+    void record(f64 ms);
+
+    const Histogram &total() const { return _total; }
+    const Histogram &window() const { return _window; }
+
+    static TimingSummary summarize(const Histogram &histogram);
+
+   private:
+    const char *_name;
+    Histogram _total;
+    Histogram _window;
+    // samples in ns, _next is where the following one goes
+    std::vector<u64> _recent;
+    u32 _next;
+};
+
+// frame and per system timing statistics. series are created on their first
+// sample and allocate nothing afterwards. written out as csv or json, picked
+// by the file extension
+class FrameStats {
+   public:
+    // frames kept in the rolling windows, about five seconds at 120 fps
+    explicit FrameStats(u32 window_size = 600u);
+
+    void record_frame(f64 ms);
+    // name must be a literal, it identifies the series
+    void record(const char *name, f64 ms);
+
+    const TimingSeries &frame() const { return _frame; }
+    const std::vector<TimingSeries> &systems() const { return _systems; }
+
+    bool write(const std::filesystem::path &path) const;
+
+   private:
+    u32 _window_size;
+    TimingSeries _frame;
+    std::vector<TimingSeries> _systems;
+
+   private:
+    bool _write_csv(const std::filesystem::path &path) const;
+    bool _write_json(const std::filesystem::path &path) const;
+};
+}  // namespace explore::core
+
+#endif  // EXPLORE_CORE_FRAME_STATS_H_
@@ -10,17 +10,23 @@ void GameContext::update_delta_time() {
         _cap_frame_rate();
     }
 
-    delta_time = (static_cast<f64>(SDL_GetTicks()) -
-                  static_cast<f64>(_previous_frame_time)) /
-                 1000.f;
+    const u64 now{SDL_GetPerformanceCounter()};
+    delta_time = static_cast<f64>(now - _previous_frame_time) /
+                 static_cast<f64>(_counter_frequency);
 
-    _previous_frame_time = SDL_GetTicks();
+    _previous_frame_time = now;
 
-    if (sample_fps) {
-        _frame_times.push_back(delta_time);
-        if (_frame_times.size() > _max_frame_samples) {
-            _frame_times.pop_front();
-        }
+    // the first delta spans everything since construction, level loading
+    // included, so only the ones after it describe frames
+    if (!_timing) {
+        _timing = true;
+        return;
+    }
+
+    _add_run_sample(delta_time * 1000.0);
+    _frame_times.push_back(delta_time);
+    if (_frame_times.size() > _max_frame_samples) {
+        _frame_times.pop_front();
     }
 }
 
@@ -40,12 +46,56 @@ u16 GameContext::FPS() const {
     return std::round(1.f / avg_dt);
 }
 
+f64 GameContext::frame_time_mean() const {
+    if (_frame_times.empty()) return 0.0;
+
+    f64 sum{0};
+    for (f64 t : _frame_times) {
+        sum += t;
+    }
+    return sum / _frame_times.size() * 1000.0;
+}
+
+f64 GameContext::frame_time_stddev() const {
+    if (_frame_times.size() < 2) return 0.0;
+
+    const f64 mean{frame_time_mean()};
+    f64 variance{0};
+    for (f64 t : _frame_times) {
+        const f64 d{t * 1000.0 - mean};
+        variance += d * d;
+    }
+    return std::sqrt(variance / (_frame_times.size() - 1));
+}
+
+f64 GameContext::run_frame_time_stddev() const {
+    if (_run_frames < 2) return 0.0;
+    return std::sqrt(_run_m2 / (_run_frames - 1));
+}
+
+void GameContext::_add_run_sample(f64 ms) {
+    ++_run_frames;
+    const f64 d{ms - _run_mean};
+    _run_mean += d / _run_frames;
+    _run_m2 += d * (ms - _run_mean);
+}
+
+f64 GameContext::_elapsed_ms(u64 since) const {
+    return static_cast<f64>(SDL_GetPerformanceCounter() - since) * 1000.0 /
+           static_cast<f64>(_counter_frequency);
+}
+
 void GameContext::_cap_frame_rate() const {
-    const i32 time_to_wait{static_cast<i32>(
-        constants::FRAME_TARGET - (SDL_GetTicks() - _previous_frame_time))};
-    // only delay if too fast
-    if (time_to_wait > 0 && time_to_wait <= constants::FRAME_TARGET) {
-        SDL_Delay(time_to_wait);
+    // only wait if too fast
+    const f64 remaining{constants::FRAME_TARGET -
+                        _elapsed_ms(_previous_frame_time)};
+    if (remaining <= 0 || remaining > constants::FRAME_TARGET) return;
+
+    // coarse sleep first, then spin on the counter for sub ms accuracy
+    if (remaining > _spin_margin) {
+        SDL_Delay(static_cast<u32>(remaining - _spin_margin));
+    }
+    while (_elapsed_ms(_previous_frame_time) < constants::FRAME_TARGET) {
     }
 }
 }  // namespace explore::core
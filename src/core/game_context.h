@@ -21,6 +21,10 @@ class GameContext {
 
     f64 delta_time;
 
+    // simulation steps per second and how many a frame may run to catch up
+    u32 tick_rate;
+    u32 max_ticks_per_frame;
+
     bool draw_collision_rects;
     bool capped_frame_rate;
     bool sample_fps;
@@ -32,23 +36,55 @@ class GameContext {
           map_width(0),
           map_height(0),
           delta_time(0.0f),
+          tick_rate(constants::TICK_RATE),
+          max_ticks_per_frame(constants::MAX_TICKS_PER_FRAME),
           draw_collision_rects(false),
           capped_frame_rate(false),
           sample_fps(false),
           _frame_times({}),
-          _previous_frame_time(0) {}
+          _timing(false),
+          _run_frames(0),
+          _run_mean(0.0),
+          _run_m2(0.0),
+          _counter_frequency(SDL_GetPerformanceFrequency()),
+          _previous_frame_time(SDL_GetPerformanceCounter()) {}
 
     void update_delta_time();
 
+    // length of one simulation step in seconds
+    f64 tick_delta_time() const { return 1.0 / tick_rate; }
+
     u16 FPS() const;
 
+    // mean and standard deviation of the last frame times in ms
+    f64 frame_time_mean() const;
+    f64 frame_time_stddev() const;
+
+    // the same over every frame of the run
+    u64 run_frames() const { return _run_frames; }
+    f64 run_frame_time_mean() const { return _run_mean; }
+    f64 run_frame_time_stddev() const;
+
    private:
     static const i32 _max_frame_samples = 100;
+    // SDL_Delay may overshoot by the scheduler granularity, so sleeping
+    // stops this many ms short of the deadline and the rest is spun
+    static constexpr f64 _spin_margin{2.0};
 
     std::deque<f64> _frame_times;
+    bool _timing;
+    // running mean and sum of squared differences in ms, welford's method
+    u64 _run_frames;
+    f64 _run_mean;
+    f64 _run_m2;
+    // performance counter ticks per second
+    u64 _counter_frequency;
     u64 _previous_frame_time;
 
    private:
+    void _add_run_sample(f64 ms);
+    f64 _elapsed_ms(u64 since) const;
+
     // TODO this function does not belong here
     void _cap_frame_rate() const;
 };
@@ -0,0 +1,83 @@
+#include "histogram.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace explore::core {
+
+Histogram::Histogram() : _buckets(), _count(0) {}
+
+u32 Histogram::bucket_index(u64 value) {
+    if (value > max_value) value = max_value;
+    if (value < sub_bucket_count) return static_cast<u32>(value);
+
+    // shift the value so its top sub_bucket_bits land in the upper half of
+    // a sub bucket range, every shift gets its own half range of buckets
+    u32 msb{63};
+    while (!(value >> msb)) --msb;
+    const u32 shift{msb - (sub_bucket_bits - 1)};
+    return shift * sub_bucket_half + static_cast<u32>(value >> shift);
+}
+
+u64 Histogram::bucket_lowest(u32 index) {
+    if (index < sub_bucket_count) return index;
+    const u32 shift{index / sub_bucket_half - 1};
+    return static_cast<u64>(index - shift * sub_bucket_half) << shift;
+}
+
+u64 Histogram::bucket_highest(u32 index) {
+    if (index < sub_bucket_count) return index;
+    const u32 shift{index / sub_bucket_half - 1};
+    return bucket_lowest(index) + (1ull << shift) - 1;
+}
+
+void Histogram::record(u64 value) {
+    ++_buckets[bucket_index(value)];
+    ++_count;
+}
+
+void Histogram::remove(u64 value) {
+    u32 &bucket{_buckets[bucket_index(value)]};
+    ASSERT_RET_V_MSG(bucket > 0, "value was never recorded");
+    --bucket;
+    --_count;
+}
+
+void Histogram::clear() {
+    _buckets.fill(0);
+    _count = 0;
+}
+
+u64 Histogram::max() const {
+    for (u32 i = bucket_count; i-- > 0;) {
+        if (_buckets[i] > 0) return bucket_highest(i);
+    }
+    return 0;
+}
+
+f64 Histogram::mean() const {
+    if (_count == 0) return 0.0;
+
+    f64 sum{0};
+    for_each_bucket([&](u64 lowest, u64 highest, u32 count) {
+        sum += (static_cast<f64>(lowest) + static_cast<f64>(highest)) * 0.5 *
+               count;
+    });
+    return sum / static_cast<f64>(_count);
+}
+
+u64 Histogram::percentile(f64 percentile) const {
+    if (_count == 0) return 0;
+
+    // rank of the value wanted, at least the first one
+    const u64 rank{std::max<u64>(
+        1, static_cast<u64>(std::ceil(percentile / 100.0 * _count)))};
+    u64 seen{0};
+    for (u32 i = 0; i < bucket_count; ++i) {
+        seen += _buckets[i];
+        if (seen >= rank) return bucket_highest(i);
+    }
+    return max();
+}
+
+}  // namespace explore::core
@@ -0,0 +1,66 @@
+#ifndef EXPLORE_CORE_HISTOGRAM_H_
+#define EXPLORE_CORE_HISTOGRAM_H_
+
+#include <array>
+
+#include "../common.h"
+
+namespace explore::core {
+// log bucketed histogram of u64 values in the style of hdr histogram. values
+// below 2^sub_bucket_bits get a bucket each, above that every power of two
+// range is split into 2^(sub_bucket_bits - 1) buckets, so a value is always
+// known to within 1 / 64 of itself. memory is fixed, recording never
+// allocates, and values past max_value are clamped
+class Histogram {
+   public:
+    static constexpr u32 sub_bucket_bits{7};
+    // largest power of two range tracked, 2^40 ns is about 18 minutes
+    static constexpr u32 max_value_bits{40};
+    static constexpr u64 max_value{(1ull << max_value_bits) - 1};
+
+    static constexpr u32 sub_bucket_count{1u << sub_bucket_bits};
+    static constexpr u32 sub_bucket_half{sub_bucket_count / 2};
+    static constexpr u32 bucket_count{
+        (max_value_bits - sub_bucket_bits) * sub_bucket_half +
+        sub_bucket_count};
+
+    Histogram();
+
+    void record(u64 value);
+    // takes back a value recorded earlier, used to slide a window
+    void remove(u64 value);
+    void clear();
+
+    u64 count() const { return _count; }
+    u64 max() const;
+    // mean of the bucket midpoints
+    f64 mean() const;
+
+    // smallest bucket bound at or below which percentile percent of the
+    // values lie, percentile in [0, 100]
+    u64 percentile(f64 percentile) const;
+
+    // calls fn(lowest, highest, count) for every bucket holding values
+    template <typename TFn>
+    void for_each_bucket(TFn &&fn) const;
+
+    static u32 bucket_index(u64 value);
+    static u64 bucket_lowest(u32 index);
+    static u64 bucket_highest(u32 index);
+
+   private:
+    std::array<u32, bucket_count> _buckets;
+    u64 _count;
+};
+
+template <typename TFn>
+void Histogram::for_each_bucket(TFn &&fn) const {
+    for (u32 i = 0; i < bucket_count; ++i) {
+        if (_buckets[i] == 0) continue;
+        fn(bucket_lowest(i), bucket_highest(i), _buckets[i]);
+    }
+}
+
+}  // namespace explore::core
+
+#endif  // EXPLORE_CORE_HISTOGRAM_H_
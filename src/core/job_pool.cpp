@@ -0,0 +1,98 @@
+#include "job_pool.h"
+
+#include <spdlog/spdlog.h>
+
+#include "./profiler.h"
+
+namespace explore::core {
+JobPool::JobPool(u32 workers)
+    : _workers(),
+      _mutex(),
+      _wake(),
+      _done(),
+      _fn(nullptr),
+      _count(0),
+      _generation(0),
+      _busy(0),
+      _stopping(false),
+      _next(0) {
+    if (workers == 0) {
+        const u32 hardware{std::thread::hardware_concurrency()};
+        workers = hardware > 1 ? hardware - 1 : 0;
+    }
+
+    _workers.reserve(workers);
+    for (u32 i = 0; i < workers; ++i) {
+        _workers.emplace_back(&JobPool::_work, this);
+    }
+    spdlog::debug("job pool started with {} workers", workers);
+}
+
+JobPool::~JobPool() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+    _wake.notify_all();
+    for (auto &worker : _workers) worker.join();
+}
+
+void JobPool::parallel_for(u32 count, const std::function<void(u32)> &fn) {
+    if (count == 0) return;
+
+    // not worth waking anyone for a single index
+    if (_workers.empty() || count == 1) {
+        for (u32 i = 0; i < count; ++i) fn(i);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _fn = &fn;
+        _count = count;
+        _next.store(0, std::memory_order_relaxed);
+        _busy = worker_count();
+        ++_generation;
+    }
+    _wake.notify_all();
+
+    _run_batch();
+
+    // fn must outlive every worker still holding the batch
+    std::unique_lock<std::mutex> lock(_mutex);
+    _done.wait(lock, [this] { return _busy == 0; });
+    _fn = nullptr;
+}
+
+void JobPool::_work() {
+    PROFILE_THREAD("job worker");
+    u64 seen{0};
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _wake.wait(lock,
+                       [&] { return _stopping || _generation != seen; });
+            if (_stopping) return;
+            seen = _generation;
+        }
+
+        {
+            PROFILE_SCOPE("JobPool::batch");
+            _run_batch();
+        }
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (--_busy == 0) _done.notify_one();
+    }
+}
+
+void JobPool::_run_batch() {
+    // indices are claimed one at a time so uneven jobs still balance out
+    for (;;) {
+        const u32 i{_next.fetch_add(1, std::memory_order_relaxed)};
+        if (i >= _count) return;
+        (*_fn)(i);
+    }
+}
+
+}  // namespace explore::core
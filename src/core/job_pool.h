@@ -0,0 +1,54 @@
+#ifndef EXPLORE_CORE_JOB_POOL_H_
+#define EXPLORE_CORE_JOB_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../common.h"
+
+namespace explore::core {
+// fixed set of worker threads running index based batches. the calling thread
+// takes part in every batch, so a pool without workers runs serially
+class JobPool {
+   public:
+    // zero picks one worker less than the hardware threads
+    explicit JobPool(u32 workers = 0);
+    ~JobPool();
+
+    JobPool(const JobPool &) = delete;
+    JobPool &operator=(const JobPool &) = delete;
+
+    u32 worker_count() const { return static_cast<u32>(_workers.size()); }
+
+    // threads a batch is spread over, workers plus the caller
+    u32 thread_count() const { return worker_count() + 1; }
+
+    // calls fn(i) for every i in [0, count) and blocks until all are done.
+    // which thread runs which index is unspecified
+    void parallel_for(u32 count, const std::function<void(u32)> &fn);
+
+   private:
+    std::vector<std::thread> _workers;
+    std::mutex _mutex;
+    std::condition_variable _wake;
+    std::condition_variable _done;
+
+    // current batch, guarded by _mutex apart from the atomics
+    const std::function<void(u32)> *_fn;
+    u32 _count;
+    u64 _generation;
+    u32 _busy;
+    bool _stopping;
+    std::atomic<u32> _next;
+
+   private:
+    void _work();
+    void _run_batch();
+};
+}  // namespace explore::core
+
+#endif  // EXPLORE_CORE_JOB_POOL_H_
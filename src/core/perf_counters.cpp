@@ -0,0 +1,172 @@
+#include "perf_counters.h"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <array>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cstring>
+#endif
+
+namespace explore::core {
+
+PerfSample &PerfSample::operator+=(const PerfSample &other) {
+    cycles += other.cycles;
+    instructions += other.instructions;
+    l1_misses += other.l1_misses;
+    llc_misses += other.llc_misses;
+    branch_misses += other.branch_misses;
+    return *this;
+}
+
+PerfSample PerfSample::operator-(const PerfSample &other) const {
+    return {cycles - other.cycles, instructions - other.instructions,
+            l1_misses - other.l1_misses, llc_misses - other.llc_misses,
+            branch_misses - other.branch_misses};
+}
+
+#ifdef __linux__
+
+static constexpr u32 counter_count{5};
+
+// counters of one thread, closed when the thread exits
+struct CounterGroup {
+    std::array<i32, counter_count> fds{-1, -1, -1, -1, -1};
+    // position of each counter in a group read, the kernel skips counters
+    // that failed to open
+    std::array<i32, counter_count> slots{-1, -1, -1, -1, -1};
+    u32 opened{0};
+
+    ~CounterGroup() {
+        for (const i32 fd : fds) {
+            if (fd >= 0) close(fd);
+        }
+    }
+};
+
+static thread_local CounterGroup group;
+
+static u64 cache_config(u64 cache) {
+    return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+           (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+}
+
+static i32 open_counter(u32 type, u64 config, i32 leader) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    // the group starts together once every counter is in it
+    attr.disabled = leader < 0 ? 1 : 0;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP;
+    return static_cast<i32>(
+        syscall(__NR_perf_event_open, &attr, 0, -1, leader, 0));
+}
+
+bool PerfCounters::open_thread() {
+    if (group.opened > 0) return true;
+
+    struct Event {
+        const char *name;
+        u32 type;
+        u64 config;
+    };
+    const std::array<Event, counter_count> events{{
+        {"cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+        {"instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+        {"l1d misses", PERF_TYPE_HW_CACHE,
+         cache_config(PERF_COUNT_HW_CACHE_L1D)},
+        {"llc misses", PERF_TYPE_HW_CACHE,
+         cache_config(PERF_COUNT_HW_CACHE_LL)},
+        {"branch misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    }};
+
+    // cycles lead the group, without them nothing else is worth reading
+    for (u32 i = 0; i < counter_count; ++i) {
+        const i32 fd{
+            open_counter(events[i].type, events[i].config, group.fds[0])};
+        if (fd < 0) {
+            ASSERT_RET_MSG(i > 0, false,
+                           "perf_event_open failed, check "
+                           "/proc/sys/kernel/perf_event_paranoid");
+            spdlog::warn("hardware counter '{}' not available",
+                         events[i].name);
+            continue;
+        }
+        group.fds[i] = fd;
+        group.slots[i] = static_cast<i32>(group.opened++);
+    }
+
+    ioctl(group.fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(group.fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    return true;
+}
+
+bool PerfCounters::is_open() { return group.opened > 0; }
+
+PerfSample PerfCounters::read() {
+    if (group.opened == 0) return {};
+
+    // PERF_FORMAT_GROUP lays out the number of counters, then their values
+    std::array<u64, counter_count + 1> values{};
+    if (::read(group.fds[0], values.data(), sizeof(values)) <= 0) return {};
+
+    const auto value{[&values](i32 slot) {
+        return slot < 0 ? 0ull : values[static_cast<u32>(slot) + 1];
+    }};
+    return {value(group.slots[0]), value(group.slots[1]),
+            value(group.slots[2]), value(group.slots[3]),
+            value(group.slots[4])};
+}
+
+#else
+
+bool PerfCounters::open_thread() {
+    spdlog::warn("hardware counters are only supported on linux");
+    return false;
+}
+
+bool PerfCounters::is_open() { return false; }
+
+PerfSample PerfCounters::read() { return {}; }
+
+#endif  // __linux__
+
+void PerfTotals::add(const char *name, const PerfSample &sample,
+                     u64 entities) {
+    // names are literals, so the pointer identifies the entry
+    auto entry{std::find_if(_entries.begin(), _entries.end(),
+                            [name](const Entry &e) { return e.name == name; })};
+    if (entry == _entries.end()) {
+        _entries.push_back({name, {}, 0});
+        entry = std::prev(_entries.end());
+    }
+    entry->sample += sample;
+    entry->entities += entities;
+}
+
+void PerfTotals::log() const {
+    if (_entries.empty()) return;
+
+    spdlog::info("{:<24} {:>6} {:>10} {:>10} {:>10}", "system", "ipc",
+                 "l1/entity", "llc/entity", "br/entity");
+    for (const Entry &entry : _entries) {
+        const f64 entities{static_cast<f64>(std::max<u64>(entry.entities, 1))};
+        spdlog::info("{:<24} {:>6.2f} {:>10.2f} {:>10.2f} {:>10.2f}",
+                     entry.name, entry.sample.ipc(),
+                     entry.sample.l1_misses / entities,
+                     entry.sample.llc_misses / entities,
+                     entry.sample.branch_misses / entities);
+    }
+}
+
+}  // namespace explore::core
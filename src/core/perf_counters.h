@@ -0,0 +1,63 @@
+#ifndef EXPLORE_CORE_PERF_COUNTERS_H_
+#define EXPLORE_CORE_PERF_COUNTERS_H_
+
+#include <vector>
+
+#include "../common.h"
+
+namespace explore::core {
+// hardware counter values, zero for counters that could not be opened
+struct PerfSample {
+    u64 cycles;
+    u64 instructions;
+    u64 l1_misses;
+    u64 llc_misses;
+    u64 branch_misses;
+
+    PerfSample &operator+=(const PerfSample &other);
+    PerfSample operator-(const PerfSample &other) const;
+
+    f64 ipc() const {
+        return cycles == 0 ? 0.0
+                           : static_cast<f64>(instructions) /
+                                 static_cast<f64>(cycles);
+    }
+};
+
+// cycles, instructions, l1d read, last level cache read and branch misses of
+// the calling thread, read through perf_event_open as one counter group.
+// linux only, everywhere else opening fails and reads return zeros. work a
+// thread hands to the job pool is not counted
+class PerfCounters {
+   public:
+    // opens and starts the counters for the calling thread. fails if the
+    // kernel refuses, see /proc/sys/kernel/perf_event_paranoid
+    static bool open_thread();
+
+    static bool is_open();
+
+    // current totals of the calling thread, one syscall
+    static PerfSample read();
+};
+
+// counters summed per system over a run
+class PerfTotals {
+   public:
+    // entities is the number of entities the system went through
+    void add(const char *name, const PerfSample &sample, u64 entities);
+
+    // logs ipc and misses per entity of every system
+    void log() const;
+
+   private:
+    struct Entry {
+        const char *name;
+        PerfSample sample;
+        u64 entities;
+    };
+
+    std::vector<Entry> _entries;
+};
+}  // namespace explore::core
+
+#endif  // EXPLORE_CORE_PERF_COUNTERS_H_
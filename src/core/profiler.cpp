@@ -0,0 +1,142 @@
+#include "profiler.h"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace explore::core {
+
+struct ProfileEvent {
+    const char *name;
+    u64 start;
+    u64 end;
+};
+
+// events of one thread, only written by that thread
+struct ThreadBuffer {
+    u32 tid;
+    const char *name;
+    std::vector<ProfileEvent> events;
+    // total events recorded, the ring holds the last buffer_capacity
+    u64 count;
+};
+
+static std::mutex buffers_mutex;
+// kept alive after their thread exits so the trace can still be written
+static std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+
+static std::filesystem::path trace_path;
+static u32 first_frame{0};
+static u32 last_frame{0};
+static std::atomic<u32> frame{0};
+
+static ThreadBuffer &thread_buffer() {
+    thread_local ThreadBuffer *buffer{nullptr};
+    if (buffer == nullptr) {
+        std::lock_guard<std::mutex> lock(buffers_mutex);
+        buffers.push_back(std::make_unique<ThreadBuffer>(ThreadBuffer{
+            static_cast<u32>(buffers.size()), nullptr, {}, 0}));
+        buffer = buffers.back().get();
+        buffer->events.resize(Profiler::buffer_capacity);
+    }
+    return *buffer;
+}
+
+void Profiler::configure(const std::filesystem::path &path, u32 first,
+                         u32 last) {
+    trace_path = path;
+    first_frame = first;
+    last_frame = last;
+    _recording = first_frame <= frame && frame <= last_frame;
+    spdlog::info("profiling frames {} to {} into {}", first_frame, last_frame,
+                 trace_path.string());
+}
+
+void Profiler::next_frame() {
+    if (trace_path.empty()) return;
+    const u32 current{++frame};
+    _recording.store(first_frame <= current && current <= last_frame,
+                     std::memory_order_relaxed);
+}
+
+void Profiler::set_thread_name(const char *name) {
+    thread_buffer().name = name;
+}
+
+u64 Profiler::now() {
+    return static_cast<u64>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+}
+
+void Profiler::record(const char *name, u64 start, u64 end) {
+    ThreadBuffer &buffer{thread_buffer()};
+    buffer.events[buffer.count % buffer_capacity] = {name, start, end};
+    ++buffer.count;
+}
+
+bool Profiler::write_trace() {
+    if (trace_path.empty()) return true;
+    _recording = false;
+
+    std::ofstream file(trace_path);
+    ASSERT_RET_MSG(file.is_open(), false, "failed to open trace '%s'",
+                   trace_path.string().c_str());
+
+    std::lock_guard<std::mutex> lock(buffers_mutex);
+
+    // timestamps are made relative to the first event of the trace
+    u64 origin{~0ull};
+    for (const auto &buffer : buffers) {
+        const u64 kept{std::min<u64>(buffer->count, buffer_capacity)};
+        for (u64 i = buffer->count - kept; i < buffer->count; ++i) {
+            origin =
+                std::min(origin, buffer->events[i % buffer_capacity].start);
+        }
+    }
+
+    // times are written in microseconds with ns precision
+    file << std::fixed << std::setprecision(3) << "{\"traceEvents\":[\n";
+    bool first{true};
+    u64 total{0};
+    u64 dropped{0};
+    for (const auto &buffer : buffers) {
+        if (buffer->name != nullptr) {
+            file << (first ? "" : ",\n")
+                 << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,"
+                 << "\"tid\":" << buffer->tid << ",\"args\":{\"name\":\""
+                 << buffer->name << "\"}}";
+            first = false;
+        }
+
+        const u64 kept{std::min<u64>(buffer->count, buffer_capacity)};
+        for (u64 i = buffer->count - kept; i < buffer->count; ++i) {
+            const ProfileEvent &event{buffer->events[i % buffer_capacity]};
+            file << (first ? "" : ",\n") << "{\"name\":\"" << event.name
+                 << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->tid
+                 << ",\"ts\":" << (event.start - origin) / 1000.0
+                 << ",\"dur\":" << (event.end - event.start) / 1000.0
+                 << "}";
+            first = false;
+        }
+        total += kept;
+        dropped += buffer->count - kept;
+    }
+    file << "\n]}\n";
+
+    if (dropped > 0) {
+        spdlog::warn("trace ring buffers overflowed, {} events dropped",
+                     dropped);
+    }
+    spdlog::info("wrote {} trace events to {}", total, trace_path.string());
+    return true;
+}
+
+}  // namespace explore::core
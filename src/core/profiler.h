@@ -0,0 +1,85 @@
+#ifndef EXPLORE_CORE_PROFILER_H_
+#define EXPLORE_CORE_PROFILER_H_
+
+#include <atomic>
+#include <filesystem>
+
+#include "../common.h"
+
+namespace explore::core {
+// records timed scopes of every thread into per thread ring buffers while the
+// current frame is inside the configured range. once every profiled thread is
+// done the events are written as a chrome trace_event json file, viewable in
+// chrome://tracing or ui.perfetto.dev. scopes are placed with the PROFILE_
+// macros below, which compile to nothing unless EXPLORE_PROFILE is defined
+class Profiler {
+   public:
+    // events kept per thread, the oldest are overwritten once full
+    static constexpr u32 buffer_capacity{1u << 16};
+
+    // records frames [first_frame, last_frame] and writes them to path
+    static void configure(const std::filesystem::path &path, u32 first_frame,
+                          u32 last_frame);
+
+    // advances the frame counter, called once per simulated frame
+    static void next_frame();
+
+    static bool recording() {
+        return _recording.load(std::memory_order_relaxed);
+    }
+
+    // names the calling thread in the trace
+    static void set_thread_name(const char *name);
+
+    // monotonic time in ns
+    static u64 now();
+
+    // name must outlive the profiler, in practice a string literal
+    static void record(const char *name, u64 start, u64 end);
+
+    // writes the trace if one was configured, call once every profiled
+    // thread is done
+    static bool write_trace();
+
+   private:
+    inline static std::atomic<bool> _recording{false};
+};
+
+// records the time between construction and destruction
+class ProfileScope {
+   public:
+    explicit ProfileScope(const char *name)
+        : _name(name),
+          _active(Profiler::recording()),
+          _start(_active ? Profiler::now() : 0) {}
+
+    ~ProfileScope() {
+        if (_active) Profiler::record(_name, _start, Profiler::now());
+    }
+
+    ProfileScope(const ProfileScope &) = delete;
+    ProfileScope &operator=(const ProfileScope &) = delete;
+
+   private:
+    const char *_name;
+    bool _active;
+    u64 _start;
+};
+}  // namespace explore::core
+
+#define EXPLORE_PROFILE_CONCAT_(a, b) a##b
+#define EXPLORE_PROFILE_CONCAT(a, b) EXPLORE_PROFILE_CONCAT_(a, b)
+
+#ifdef EXPLORE_PROFILE
+#define PROFILE_SCOPE(name)                                                    \
+    ::explore::core::ProfileScope EXPLORE_PROFILE_CONCAT(_profile_scope_,      \
+                                                         __LINE__)(name)
+#define PROFILE_FRAME() ::explore::core::Profiler::next_frame()
+#define PROFILE_THREAD(name) ::explore::core::Profiler::set_thread_name(name)
+#else
+#define PROFILE_SCOPE(name) (void)0
+#define PROFILE_FRAME() (void)0
+#define PROFILE_THREAD(name) (void)0
+#endif
+
+#endif  // EXPLORE_CORE_PROFILER_H_
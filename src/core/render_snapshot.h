@@ -0,0 +1,108 @@
+#ifndef EXPLORE_CORE_RENDER_SNAPSHOT_H_
+#define EXPLORE_CORE_RENDER_SNAPSHOT_H_
+
+#include <SDL_rect.h>
+
+#include <vector>
+
+#include "../common.h"
+#include "../ecs/components.h"
+#include "./command_buffer.h"
+#include "./frame_stats.h"
+#include "./perf_counters.h"
+
+namespace explore::core {
+class Texture2D;
+
+// what a frame drew and what it skipped for being off camera
+struct RenderStats {
+    u32 drawn;
+    u32 culled;
+    // draw calls the drawn items were submitted with
+    u32 batches;
+};
+
+// time a system took over one frame and the entities it runs on
+struct SystemStats {
+    const char *name;
+    f64 time;
+    u32 entities;
+    // times the system ran during the frame
+    u32 calls;
+    // hardware counters over those runs, zero unless counters are open
+    PerfSample counters;
+
+    // entities gone through over all runs, what counters are divided by.
+    // render systems get their count from the snapshot, never from the
+    // entity lists the simulation is changing
+    u64 entity_visits() const { return static_cast<u64>(entities) * calls; }
+};
+
+// occupancy of a component pool
+struct PoolStats {
+    // mangled name of the component type
+    const char *type_name;
+    u32 size;
+    u32 capacity;
+};
+
+// events of one type emitted during a frame
+struct EventStats {
+    // mangled name of the event type
+    const char *type_name;
+    u32 count;
+};
+
+// copy of a tilemap grid as of the snapshot
+struct TilemapSnapshot {
+    const Texture2D *tileset{nullptr};
+    // refreshed only when the generation or revision of the source changes
+    component::Tilemap tilemap;
+    // chunks edited since the previous snapshot
+    std::vector<u32> edited_chunks;
+};
+
+// everything the renderer needs to draw one frame, produced by the
+// simulation and never touched by it again until the renderer hands it back.
+// buffers are reused between frames so steady state does not allocate
+struct RenderSnapshot {
+    SDL_Rect camera{0, 0, 0, 0};
+
+    std::vector<TilemapSnapshot> tilemaps;
+    // visible sprites with screen space destinations, sorted by the renderer
+    CommandBuffer sprites;
+    // collider outlines in screen space, empty unless enabled
+    std::vector<SDL_Rect> debug_rects;
+
+    RenderStats sprite_stats{0, 0, 0};
+    RenderStats tile_stats{0, 0, 0};
+
+    // frame rate seen by the simulation, logged by the renderer if sampled
+    bool sample_fps{false};
+    u16 fps{0};
+    // mean and standard deviation of the last frame times in ms, kept
+    // whether or not fps is sampled
+    f64 frame_time{0.0};
+    f64 frame_time_stddev{0.0};
+    // frame time percentiles over the rolling window
+    TimingSummary frame_window{0, 0.0, 0.0, 0.0, 0.0, 0.0};
+
+    // simulation side numbers shown by the overlay, times in ms
+    f64 delta_time{0.0};
+    u32 entities{0};
+    std::vector<SystemStats> systems;
+    std::vector<PoolStats> pools;
+    std::vector<EventStats> events;
+    // entities of the render systems, counted by the simulation since their
+    // entity lists change on its thread
+    u32 tilemap_entities{0};
+    u32 sprite_entities{0};
+    u32 debug_entities{0};
+
+    // filled by the renderer, read back by the simulation when the snapshot
+    // is next written
+    std::vector<SystemStats> render_systems;
+};
+}  // namespace explore::core
+
+#endif  // EXPLORE_CORE_RENDER_SNAPSHOT_H_
@@ -0,0 +1,222 @@
+#include "simd_aabb.h"
+
+#include <SDL_cpuinfo.h>
+#include <spdlog/spdlog.h>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || \
+    defined(_M_IX86)
+#define EXPLORE_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+// gcc and clang only emit avx2 code for functions that opt in
+#if defined(__GNUC__) || defined(__clang__)
+#define EXPLORE_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define EXPLORE_TARGET_AVX2
+#endif
+
+namespace explore::core {
+
+void AABBBuffer::resize(u32 count) {
+    _min_x.resize(count);
+    _min_y.resize(count);
+    _max_x.resize(count);
+    _max_y.resize(count);
+    _layer.resize(count);
+    _mask.resize(count);
+}
+
+void AABBBuffer::set(u32 index, const AABB &box, u32 layer, u32 mask) {
+    _min_x[index] = box.min.x;
+    _min_y[index] = box.min.y;
+    _max_x[index] = box.max.x;
+    _max_y[index] = box.max.y;
+    _layer[index] = layer;
+    _mask[index] = mask;
+}
+
+void AABBBuffer::gather(const AABBBuffer &source, const u32 *indices,
+                        u32 count) {
+    if (count > size()) resize(count);
+    for (u32 i = 0; i < count; ++i) {
+        const u32 index{indices[i]};
+        _min_x[i] = source._min_x[index];
+        _min_y[i] = source._min_y[index];
+        _max_x[i] = source._max_x[index];
+        _max_y[i] = source._max_y[index];
+        _layer[i] = source._layer[index];
+        _mask[i] = source._mask[index];
+    }
+}
+
+static u32 overlap_batch_scalar(const AABBQuery &q, const AABBArrays &c,
+                                u32 count, u32 *out) {
+    u32 hits{0};
+    for (u32 i = 0; i < count; ++i) {
+        const bool overlap{q.min_x < c.max_x[i] && q.max_x > c.min_x[i] &&
+                           q.min_y < c.max_y[i] && q.max_y > c.min_y[i]};
+        const bool interacts{(q.layer & c.mask[i]) != 0 &&
+                             (c.layer[i] & q.mask) != 0};
+        out[hits] = i;
+        hits += static_cast<u32>(overlap && interacts);
+    }
+    return hits;
+}
+
+#ifdef EXPLORE_SIMD_X86
+
+// writes the index of every set bit in bits, offset by base
+static inline u32 write_hits(u32 bits, u32 base, u32 *out) {
+    u32 hits{0};
+    while (bits) {
+#if defined(__GNUC__) || defined(__clang__)
+        const u32 lane{static_cast<u32>(__builtin_ctz(bits))};
+#else
+        unsigned long lane;
+        _BitScanForward(&lane, bits);
+#endif
+        out[hits++] = base + lane;
+        bits &= bits - 1;
+    }
+    return hits;
+}
+
+static u32 overlap_batch_sse2(const AABBQuery &q, const AABBArrays &c,
+                              u32 count, u32 *out) {
+    const __m128 q_min_x{_mm_set1_ps(q.min_x)};
+    const __m128 q_min_y{_mm_set1_ps(q.min_y)};
+    const __m128 q_max_x{_mm_set1_ps(q.max_x)};
+    const __m128 q_max_y{_mm_set1_ps(q.max_y)};
+    const __m128i q_layer{_mm_set1_epi32(static_cast<i32>(q.layer))};
+    const __m128i q_mask{_mm_set1_epi32(static_cast<i32>(q.mask))};
+    const __m128i zero{_mm_setzero_si128()};
+
+    u32 hits{0};
+    u32 i{0};
+    for (; i + 4 <= count; i += 4) {
+        __m128 overlap{_mm_cmplt_ps(q_min_x, _mm_loadu_ps(c.max_x + i))};
+        overlap = _mm_and_ps(
+            overlap, _mm_cmpgt_ps(q_max_x, _mm_loadu_ps(c.min_x + i)));
+        overlap = _mm_and_ps(
+            overlap, _mm_cmplt_ps(q_min_y, _mm_loadu_ps(c.max_y + i)));
+        overlap = _mm_and_ps(
+            overlap, _mm_cmpgt_ps(q_max_y, _mm_loadu_ps(c.min_y + i)));
+
+        const __m128i layer{
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(c.layer + i))};
+        const __m128i mask{
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(c.mask + i))};
+        // lanes where either side of the filter is zero are rejected
+        const __m128i rejected{
+            _mm_or_si128(_mm_cmpeq_epi32(_mm_and_si128(q_layer, mask), zero),
+                         _mm_cmpeq_epi32(_mm_and_si128(layer, q_mask), zero))};
+
+        const u32 bits{static_cast<u32>(_mm_movemask_ps(
+            _mm_andnot_ps(_mm_castsi128_ps(rejected), overlap)))};
+        hits += write_hits(bits, i, out + hits);
+    }
+
+    if (i < count) {
+        const AABBArrays tail{c.min_x + i, c.min_y + i, c.max_x + i,
+                              c.max_y + i, c.layer + i, c.mask + i};
+        const u32 tail_hits{overlap_batch_scalar(q, tail, count - i,
+                                                 out + hits)};
+        for (u32 h = 0; h < tail_hits; ++h) out[hits + h] += i;
+        hits += tail_hits;
+    }
+    return hits;
+}
+
+EXPLORE_TARGET_AVX2
+static u32 overlap_batch_avx2(const AABBQuery &q, const AABBArrays &c,
+                              u32 count, u32 *out) {
+    const __m256 q_min_x{_mm256_set1_ps(q.min_x)};
+    const __m256 q_min_y{_mm256_set1_ps(q.min_y)};
+    const __m256 q_max_x{_mm256_set1_ps(q.max_x)};
+    const __m256 q_max_y{_mm256_set1_ps(q.max_y)};
+    const __m256i q_layer{_mm256_set1_epi32(static_cast<i32>(q.layer))};
+    const __m256i q_mask{_mm256_set1_epi32(static_cast<i32>(q.mask))};
+    const __m256i zero{_mm256_setzero_si256()};
+
+    u32 hits{0};
+    u32 i{0};
+    for (; i + 8 <= count; i += 8) {
+        __m256 overlap{
+            _mm256_cmp_ps(q_min_x, _mm256_loadu_ps(c.max_x + i), _CMP_LT_OQ)};
+        overlap = _mm256_and_ps(
+            overlap,
+            _mm256_cmp_ps(q_max_x, _mm256_loadu_ps(c.min_x + i), _CMP_GT_OQ));
+        overlap = _mm256_and_ps(
+            overlap,
+            _mm256_cmp_ps(q_min_y, _mm256_loadu_ps(c.max_y + i), _CMP_LT_OQ));
+        overlap = _mm256_and_ps(
+            overlap,
+            _mm256_cmp_ps(q_max_y, _mm256_loadu_ps(c.min_y + i), _CMP_GT_OQ));
+
+        const __m256i layer{_mm256_loadu_si256(
+            reinterpret_cast<const __m256i *>(c.layer + i))};
+        const __m256i mask{_mm256_loadu_si256(
+            reinterpret_cast<const __m256i *>(c.mask + i))};
+        const __m256i rejected{_mm256_or_si256(
+            _mm256_cmpeq_epi32(_mm256_and_si256(q_layer, mask), zero),
+            _mm256_cmpeq_epi32(_mm256_and_si256(layer, q_mask), zero))};
+
+        const u32 bits{static_cast<u32>(_mm256_movemask_ps(
+            _mm256_andnot_ps(_mm256_castsi256_ps(rejected), overlap)))};
+        hits += write_hits(bits, i, out + hits);
+    }
+
+    if (i < count) {
+        const AABBArrays tail{c.min_x + i, c.min_y + i, c.max_x + i,
+                              c.max_y + i, c.layer + i, c.mask + i};
+        const u32 tail_hits{overlap_batch_sse2(q, tail, count - i,
+                                               out + hits)};
+        for (u32 h = 0; h < tail_hits; ++h) out[hits + h] += i;
+        hits += tail_hits;
+    }
+    return hits;
+}
+
+#endif  // EXPLORE_SIMD_X86
+
+SimdLevel detect_simd_level() {
+#ifdef EXPLORE_SIMD_X86
+    if (SDL_HasAVX2()) return SimdLevel::AVX2;
+    if (SDL_HasSSE2()) return SimdLevel::SSE2;
+#endif
+    return SimdLevel::Scalar;
+}
+
+OverlapBatchFn overlap_batch_fn(SimdLevel &level) {
+    const SimdLevel supported{detect_simd_level()};
+    if (static_cast<i32>(level) > static_cast<i32>(supported)) {
+        spdlog::warn("simd level '{}' not supported, using '{}'",
+                     simd_level_name(level), simd_level_name(supported));
+        level = supported;
+    }
+
+    switch (level) {
+#ifdef EXPLORE_SIMD_X86
+        case SimdLevel::AVX2:
+            return overlap_batch_avx2;
+        case SimdLevel::SSE2:
+            return overlap_batch_sse2;
+#endif
+        default:
+            return overlap_batch_scalar;
+    }
+}
+
+const char *simd_level_name(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::AVX2:
+            return "avx2";
+        case SimdLevel::SSE2:
+            return "sse2";
+        default:
+            return "scalar";
+    }
+}
+
+}  // namespace explore::core
@@ -0,0 +1,88 @@
+#ifndef EXPLORE_CORE_SIMD_AABB_H_
+#define EXPLORE_CORE_SIMD_AABB_H_
+
+#include <vector>
+
+#include "../common.h"
+#include "./aabb.h"
+
+namespace explore::core {
+/* instruction sets the batch overlap test can run on */
+enum class SimdLevel { Scalar, SSE2, AVX2 };
+
+// structure of arrays view over world space boxes and their layer filters
+struct AABBArrays {
+    const f32 *min_x;
+    const f32 *min_y;
+    const f32 *max_x;
+    const f32 *max_y;
+    const u32 *layer;
+    const u32 *mask;
+};
+
+// single box tested against a batch of candidates
+struct AABBQuery {
+    f32 min_x;
+    f32 min_y;
+    f32 max_x;
+    f32 max_y;
+    u32 layer;
+    u32 mask;
+};
+
+// owning structure of arrays storage for boxes fed to the batch test
+class AABBBuffer {
+   public:
+    u32 size() const { return static_cast<u32>(_min_x.size()); }
+
+    void resize(u32 count);
+
+    void set(u32 index, const AABB &box, u32 layer, u32 mask);
+
+    // copies the boxes at indices of source into [0, count)
+    void gather(const AABBBuffer &source, const u32 *indices, u32 count);
+
+    AABB get(u32 index) const {
+        return AABB(glm::vec2(_min_x[index], _min_y[index]),
+                    glm::vec2(_max_x[index], _max_y[index]));
+    }
+
+    // view of the boxes from offset onwards
+    AABBArrays view(u32 offset = 0) const {
+        return {_min_x.data() + offset, _min_y.data() + offset,
+                _max_x.data() + offset, _max_y.data() + offset,
+                _layer.data() + offset, _mask.data() + offset};
+    }
+
+    AABBQuery query(u32 index) const {
+        return {_min_x[index], _min_y[index], _max_x[index],
+                _max_y[index], _layer[index], _mask[index]};
+    }
+
+   private:
+    std::vector<f32> _min_x;
+    std::vector<f32> _min_y;
+    std::vector<f32> _max_x;
+    std::vector<f32> _max_y;
+    std::vector<u32> _layer;
+    std::vector<u32> _mask;
+};
+
+// tests query against candidates [0, count). the index of every candidate that
+// overlaps and shares a layer with query is written to out, which must have
+// room for count entries. returns the number of hits written, in order
+typedef u32 (*OverlapBatchFn)(const AABBQuery &query,
+                              const AABBArrays &candidates, u32 count,
+                              u32 *out);
+
+// best instruction set supported by the running cpu
+SimdLevel detect_simd_level();
+
+// overlap kernel for level. a level the cpu does not support is lowered to
+// the best one it does with a warning, level is left holding the one used
+OverlapBatchFn overlap_batch_fn(SimdLevel &level);
+
+const char *simd_level_name(SimdLevel level);
+}  // namespace explore::core
+
+#endif  // EXPLORE_CORE_SIMD_AABB_H_
@@ -0,0 +1,81 @@
+#include "snapshot_queue.h"
+
+namespace explore::core {
+static constexpr u32 no_snapshot{~0u};
+
+SnapshotQueue::SnapshotQueue()
+    : _snapshots(),
+      _mutex(),
+      _changed(),
+      _free(),
+      _ready(),
+      _writing(no_snapshot),
+      _reading(no_snapshot),
+      _stopped(false) {
+    reset();
+}
+
+RenderSnapshot *SnapshotQueue::begin_write() {
+    std::unique_lock<std::mutex> lock(_mutex);
+    ASSERT_RET_MSG(_writing == no_snapshot, nullptr,
+                   "snapshot already being written");
+    _changed.wait(lock, [this] { return _stopped || !_free.empty(); });
+    if (_stopped) return nullptr;
+
+    _writing = _free.back();
+    _free.pop_back();
+    return &_snapshots[_writing];
+}
+
+void SnapshotQueue::end_write() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        ASSERT_RET_V_MSG(_writing != no_snapshot, "no snapshot being written");
+        _ready.push_back(_writing);
+        _writing = no_snapshot;
+    }
+    _changed.notify_all();
+}
+
+RenderSnapshot *SnapshotQueue::begin_read() {
+    std::unique_lock<std::mutex> lock(_mutex);
+    ASSERT_RET_MSG(_reading == no_snapshot, nullptr,
+                   "snapshot already being read");
+    _changed.wait(lock, [this] { return _stopped || !_ready.empty(); });
+    // published snapshots are still handed out after a stop
+    if (_ready.empty()) return nullptr;
+
+    _reading = _ready.front();
+    _ready.pop_front();
+    return &_snapshots[_reading];
+}
+
+void SnapshotQueue::end_read() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        ASSERT_RET_V_MSG(_reading != no_snapshot, "no snapshot being read");
+        _free.push_back(_reading);
+        _reading = no_snapshot;
+    }
+    _changed.notify_all();
+}
+
+void SnapshotQueue::stop() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopped = true;
+    }
+    _changed.notify_all();
+}
+
+void SnapshotQueue::reset() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _free.clear();
+    _ready.clear();
+    for (u32 i = buffer_count; i-- > 0;) _free.push_back(i);
+    _writing = no_snapshot;
+    _reading = no_snapshot;
+    _stopped = false;
+}
+
+}  // namespace explore::core
@@ -0,0 +1,51 @@
+#ifndef EXPLORE_CORE_SNAPSHOT_QUEUE_H_
+#define EXPLORE_CORE_SNAPSHOT_QUEUE_H_
+
+#include <array>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+#include "../common.h"
+#include "./render_snapshot.h"
+
+namespace explore::core {
+// double buffered hand off of render snapshots between the simulation and
+// the renderer. the simulation fills one snapshot while the renderer draws
+// the other, snapshots are read in the order they were written and never
+// dropped. every call blocks until its buffer is available or stop() is called
+class SnapshotQueue {
+   public:
+    static constexpr u32 buffer_count{2u};
+
+    SnapshotQueue();
+
+    // free snapshot to fill, null once stopped
+    RenderSnapshot *begin_write();
+    // publishes the snapshot returned by begin_write
+    void end_write();
+
+    // oldest published snapshot, null once stopped and none are left
+    RenderSnapshot *begin_read();
+    // gives the snapshot returned by begin_read back to the writer
+    void end_read();
+
+    // wakes and fails every waiting and future begin call
+    void stop();
+    void reset();
+
+   private:
+    std::array<RenderSnapshot, buffer_count> _snapshots;
+
+    std::mutex _mutex;
+    std::condition_variable _changed;
+    std::vector<u32> _free;
+    std::deque<u32> _ready;
+    u32 _writing;
+    u32 _reading;
+    bool _stopped;
+};
+}  // namespace explore::core
+
+#endif  // EXPLORE_CORE_SNAPSHOT_QUEUE_H_
@@ -0,0 +1,78 @@
+#include "spatial_grid.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace explore::core {
+SpatialGrid::SpatialGrid(u32 cell_size)
+    : _cell_size(cell_size > 0 ? cell_size : 1u),
+      _entries(),
+      _indices(),
+      _cells(),
+      _origins() {}
+
+void SpatialGrid::set_cell_size(u32 cell_size) {
+    ASSERT_RET_V_MSG(cell_size > 0, "cell size must be greater than zero");
+    _cell_size = cell_size;
+}
+
+void SpatialGrid::clear() {
+    _entries.clear();
+    _indices.clear();
+    _cells.clear();
+    _origins.clear();
+}
+
+void SpatialGrid::insert(u32 index, const AABB &box) {
+    const i32 x0{_cell_coord(box.min.x)};
+    const i32 y0{_cell_coord(box.min.y)};
+    // a box ending exactly on a cell edge registers one extra cell, which
+    // only costs a rejected candidate
+    const i32 x1{_cell_coord(box.max.x)};
+    const i32 y1{_cell_coord(box.max.y)};
+
+    if (index >= _origins.size()) {
+        _origins.resize(index + 1);
+    }
+    _origins[index] = {x0, y0};
+
+    for (i32 y = y0; y <= y1; ++y) {
+        for (i32 x = x0; x <= x1; ++x) {
+            _entries.push_back({_cell_key(x, y), index});
+        }
+    }
+}
+
+void SpatialGrid::build() {
+    std::sort(_entries.begin(), _entries.end(),
+              [](const Entry &a, const Entry &b) {
+                  return a.cell < b.cell ||
+                         (a.cell == b.cell && a.index < b.index);
+              });
+
+    _indices.resize(_entries.size());
+    for (size_t i = 0; i < _entries.size(); ++i) {
+        _indices[i] = _entries[i].index;
+    }
+
+    // split the sorted entries into runs so cells can be handed out by index
+    const u32 count{static_cast<u32>(_entries.size())};
+    u32 begin{0};
+    while (begin < count) {
+        const u64 cell{_entries[begin].cell};
+        u32 end{begin + 1};
+        while (end < count && _entries[end].cell == cell) ++end;
+
+        _cells.push_back({begin, end - begin,
+                          static_cast<i32>(static_cast<u32>(cell >> 32)),
+                          static_cast<i32>(static_cast<u32>(cell))});
+        begin = end;
+    }
+}
+
+i32 SpatialGrid::_cell_coord(f32 v) const {
+    // floor so negative coordinates land in the correct cell
+    return static_cast<i32>(std::floor(v / static_cast<f32>(_cell_size)));
+}
+
+}  // namespace explore::core
@@ -0,0 +1,113 @@
+#ifndef EXPLORE_CORE_SPATIAL_GRID_H_
+#define EXPLORE_CORE_SPATIAL_GRID_H_
+
+#include <vector>
+
+#include "../common.h"
+#include "./aabb.h"
+
+namespace explore::core {
+// uniform grid spatial hash. every inserted rect is registered in each cell it
+// touches, the entries are then sorted by cell so that all occupants of a cell
+// are contiguous. meant to be rebuilt from scratch every frame
+class SpatialGrid {
+   public:
+    // run of sorted entries sharing one cell
+    struct Cell {
+        u32 begin;
+        u32 count;
+        i32 x;
+        i32 y;
+    };
+
+    explicit SpatialGrid(u32 cell_size = 64u);
+
+    u32 cell_size() const { return _cell_size; }
+    void set_cell_size(u32 cell_size);
+
+    void clear();
+
+    // registers box under index, index must be unique between clear() calls
+    void insert(u32 index, const AABB &box);
+
+    // sorts the registered entries, call once after all inserts
+    void build();
+
+    // calls fn(a, b) exactly once for every pair of indices sharing at least
+    // one cell, with a < b. pairs are visited in a deterministic order
+    template <typename TFn>
+    void for_each_pair(TFn &&fn) const;
+
+    // calls fn(indices, count, cell_x, cell_y) for every occupied cell, the
+    // indices of a cell are sorted
+    template <typename TFn>
+    void for_each_cell(TFn &&fn) const;
+
+    // occupied cells in sorted order, valid until the next clear()
+    const std::vector<Cell> &cells() const { return _cells; }
+
+    // sorted indices of the rects registered in cell
+    const u32 *cell_indices(const Cell &cell) const {
+        return _indices.data() + cell.begin;
+    }
+
+    // true if the cell is the first one shared by a and b. a pair sharing
+    // several cells is only reported from that cell, avoiding a dedupe set
+    bool owns_pair(u32 a, u32 b, i32 cell_x, i32 cell_y) const {
+        const CellRange &oa{_origins[a]};
+        const CellRange &ob{_origins[b]};
+        return (oa.x > ob.x ? oa.x : ob.x) == cell_x &&
+               (oa.y > ob.y ? oa.y : ob.y) == cell_y;
+    }
+
+   private:
+    struct Entry {
+        u64 cell;
+        u32 index;
+    };
+
+    struct CellRange {
+        i32 x;
+        i32 y;
+    };
+
+    i32 _cell_coord(f32 v) const;
+
+    static u64 _cell_key(i32 x, i32 y) {
+        return (static_cast<u64>(static_cast<u32>(x)) << 32) |
+               static_cast<u64>(static_cast<u32>(y));
+    }
+
+    u32 _cell_size;
+
+    std::vector<Entry> _entries;
+    // indices of _entries in cell order, handed out by for_each_cell
+    std::vector<u32> _indices;
+    std::vector<Cell> _cells;
+    // top-left cell of every inserted rect, indexed by the insert index
+    std::vector<CellRange> _origins;
+};
+
+template <typename TFn>
+void SpatialGrid::for_each_pair(TFn &&fn) const {
+    for_each_cell([&](const u32 *indices, u32 count, i32 cx, i32 cy) {
+        for (u32 i = 0; i < count; ++i) {
+            for (u32 j = i + 1; j < count; ++j) {
+                if (owns_pair(indices[i], indices[j], cx, cy)) {
+                    fn(indices[i], indices[j]);
+                }
+            }
+        }
+    });
+}
+
+template <typename TFn>
+void SpatialGrid::for_each_cell(TFn &&fn) const {
+    for (const Cell &cell : _cells) {
+        fn(cell_indices(cell), cell.count, cell.x, cell.y);
+    }
+}
+
+}  // namespace explore::core
+
+#endif  // EXPLORE_CORE_SPATIAL_GRID_H_
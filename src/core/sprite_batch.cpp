@@ -0,0 +1,73 @@
+#include "sprite_batch.h"
+
+#include <cmath>
+
+#include "./texture2d.h"
+
+namespace explore::core {
+static constexpr f64 pi{3.14159265358979323846};
+
+SpriteBatch::SpriteBatch()
+    : _texture(nullptr),
+      _inv_width(0.f),
+      _inv_height(0.f),
+      _vertices(),
+      _indices() {}
+
+void SpriteBatch::begin(const Texture2D &texture) {
+    clear();
+    const Texture2D &page{texture.get_page()};
+    _texture = &page;
+    _inv_width = page.get_width() ? 1.f / page.get_width() : 0.f;
+    _inv_height = page.get_height() ? 1.f / page.get_height() : 0.f;
+}
+
+void SpriteBatch::clear() {
+    _texture = nullptr;
+    _vertices.clear();
+    _indices.clear();
+}
+
+void SpriteBatch::add(const Texture2D &texture, const SDL_Rect &src,
+                      const SDL_Rect &dst, f64 angle) {
+    ASSERT_RET_V(&texture.get_page() == _texture);
+    const SDL_Color white{255, 255, 255, 255};
+
+    const SDL_Rect page_src{texture.to_page(src)};
+    const f32 u0{page_src.x * _inv_width};
+    const f32 v0{page_src.y * _inv_height};
+    const f32 u1{(page_src.x + page_src.w) * _inv_width};
+    const f32 v1{(page_src.y + page_src.h) * _inv_height};
+
+    // corners relative to the center of dst, in the order tl, tr, br, bl
+    const f32 half_w{dst.w * 0.5f};
+    const f32 half_h{dst.h * 0.5f};
+    const f32 cx{dst.x + half_w};
+    const f32 cy{dst.y + half_h};
+    const f32 dx[4]{-half_w, half_w, half_w, -half_w};
+    const f32 dy[4]{-half_h, -half_h, half_h, half_h};
+    const f32 u[4]{u0, u1, u1, u0};
+    const f32 v[4]{v0, v0, v1, v1};
+
+    // y points down, so a positive angle turns clockwise on screen
+    f32 c{1.f};
+    f32 s{0.f};
+    if (angle != 0.0) {
+        const f64 radians{angle * pi / 180.0};
+        c = static_cast<f32>(std::cos(radians));
+        s = static_cast<f32>(std::sin(radians));
+    }
+
+    const i32 base{static_cast<i32>(_vertices.size())};
+    for (u32 i = 0; i < 4; ++i) {
+        _vertices.push_back({{cx + c * dx[i] - s * dy[i],
+                              cy + s * dx[i] + c * dy[i]},
+                             white,
+                             {u[i], v[i]}});
+    }
+
+    const i32 quad[6]{0, 1, 2, 0, 2, 3};
+    for (const i32 index : quad) _indices.push_back(base + index);
+}
+
+}  // namespace explore::core
@@ -0,0 +1,48 @@
+#ifndef EXPLORE_CORE_SPRITE_BATCH_H_
+#define EXPLORE_CORE_SPRITE_BATCH_H_
+
+#include <SDL_rect.h>
+#include <SDL_render.h>
+
+#include <vector>
+
+#include "../common.h"
+
+namespace explore::core {
+class Texture2D;
+
+// quads sharing one texture, collected on the cpu and submitted with a single
+// SDL_RenderGeometry call by ScreenManager::draw_batch. atlased textures are
+// batched by their page, so images sharing a page share a batch
+class SpriteBatch {
+   public:
+    SpriteBatch();
+
+    const Texture2D *texture() const { return _texture; }
+    bool empty() const { return _indices.empty(); }
+    u32 size() const { return static_cast<u32>(_vertices.size() / 4); }
+
+    const std::vector<SDL_Vertex> &vertices() const { return _vertices; }
+    const std::vector<i32> &indices() const { return _indices; }
+
+    // drops the collected quads and starts collecting for the page of texture
+    void begin(const Texture2D &texture);
+    void clear();
+
+    // adds src of texture drawn to dst, rotated by angle degrees clockwise
+    // around the center of dst. matches SDL_RenderCopyEx. texture must live in
+    // the page the batch was started with
+    void add(const Texture2D &texture, const SDL_Rect &src, const SDL_Rect &dst,
+             f64 angle);
+
+   private:
+    const Texture2D *_texture;
+    f32 _inv_width;
+    f32 _inv_height;
+
+    std::vector<SDL_Vertex> _vertices;
+    std::vector<i32> _indices;
+};
+}  // namespace explore::core
+
+#endif  // EXPLORE_CORE_SPRITE_BATCH_H_
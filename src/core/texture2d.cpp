@@ -6,37 +6,84 @@
 
 namespace explore::core {
 Texture2D::Texture2D()
-    : _name(""), _path(""), _data(nullptr), _width(0), _height(0) {}
+    : _name(""),
+      _path(""),
+      _data(nullptr),
+      _width(0),
+      _height(0),
+      _handle(0),
+      _page(nullptr),
+      _offset_x(0),
+      _offset_y(0) {}
 
 Texture2D::Texture2D(std::string name, std::filesystem::path path)
     : _name(std::move(name)),
       _path(std::move(path)),
       _data(nullptr),
       _width(0),
-      _height(0) {}
+      _height(0),
+      _handle(0),
+      _page(nullptr),
+      _offset_x(0),
+      _offset_y(0) {}
 
 bool Texture2D::initialize(SDL_Renderer *renderer) {
     SDL_Surface *surface{IMG_Load(_path.string().c_str())};
     ASSERT_RET(surface, false);
 
+    const bool initialized{initialize(renderer, surface)};
+    SDL_FreeSurface(surface);
+    ASSERT_RET(initialized, false);
+
+    spdlog::debug("TEXTURE: initialized '{}' '{}x{}' with path '{}'", _name,
+                  _width, _height, _path.string());
+    return true;
+}
+
+bool Texture2D::initialize(SDL_Renderer *renderer, SDL_Surface *surface) {
     SDL_Texture *sdl_texture{SDL_CreateTextureFromSurface(renderer, surface)};
     ASSERT_RET(sdl_texture, false);
 
     _width = surface->w;
     _height = surface->h;
 
-    SDL_FreeSurface(surface);
+    _data = sdl_texture;
+    return true;
+}
 
-    spdlog::debug("TEXTURE: initialized '{}' '{}x{}' with path '{}'", _name,
-                  _width, _height, _path.string());
+bool Texture2D::initialize_target(SDL_Renderer *renderer, u32 width,
+                                  u32 height) {
+    SDL_Texture *sdl_texture{SDL_CreateTexture(
+        renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET,
+        static_cast<i32>(width), static_cast<i32>(height))};
+    ASSERT_RET(sdl_texture, false);
+
+    // empty pixels must stay see-through once drawn
+    SDL_SetTextureBlendMode(sdl_texture, SDL_BLENDMODE_BLEND);
+
+    _width = width;
+    _height = height;
+
+    spdlog::debug("TEXTURE: initialized target '{}' '{}x{}'", _name, _width,
+                  _height);
 
     _data = sdl_texture;
     return true;
 }
 
+void Texture2D::set_atlas_region(const Texture2D &page, i32 x, i32 y) {
+    if (!_page) SDL_DestroyTexture(_data);
+
+    _data = page.get_data();
+    _page = &page;
+    _offset_x = x;
+    _offset_y = y;
+}
+
 Texture2D::~Texture2D() {
     spdlog::debug("destroying texture: '{}'", _name);
-    SDL_DestroyTexture(_data);
+    // the page owns the pixels of atlased textures
+    if (!_page) SDL_DestroyTexture(_data);
     _data = nullptr;
 }
 
@@ -9,6 +9,7 @@
 #include "../common.h"
 
 struct SDL_Renderer;
+struct SDL_Surface;
 
 namespace explore::core {
 class Texture2D {
@@ -21,20 +22,59 @@ class Texture2D {
     [[nodiscard]] const std::filesystem::path &get_path() const {
         return _path;
     }
+    // for atlased textures this is the texture of the atlas page
     [[nodiscard]] SDL_Texture *get_data() const { return _data; }
     [[nodiscard]] u32 get_width() const { return _width; }
     [[nodiscard]] u32 get_height() const { return _height; }
 
+    // small id handed out by the resource manager, used in draw sort keys
+    [[nodiscard]] u32 get_handle() const { return _handle; }
+    void set_handle(u32 handle) { _handle = handle; }
+
+    [[nodiscard]] bool is_atlased() const { return _page != nullptr; }
+    // texture the pixels live in, itself unless atlased
+    [[nodiscard]] const Texture2D &get_page() const {
+        return _page ? *_page : *this;
+    }
+    // area of the page holding this image
+    [[nodiscard]] SDL_Rect get_region() const {
+        return {_offset_x, _offset_y, static_cast<i32>(_width),
+                static_cast<i32>(_height)};
+    }
+    // maps a rect of the original image to the same pixels in the page
+    [[nodiscard]] SDL_Rect to_page(SDL_Rect src) const {
+        src.x += _offset_x;
+        src.y += _offset_y;
+        return src;
+    }
+
     bool initialize(SDL_Renderer *renderer);
 
+    // creates the texture from surface, the caller keeps the surface
+    bool initialize(SDL_Renderer *renderer, SDL_Surface *surface);
+
+    // creates an empty texture that can be rendered into, see
+    // ScreenManager::set_render_target
+    bool initialize_target(SDL_Renderer *renderer, u32 width, u32 height);
+
+    // releases the own texture and draws from the region at x,y of page
+    // instead. page must outlive this texture
+    void set_atlas_region(const Texture2D &page, i32 x, i32 y);
+
    private:
     const std::string _name;
     const std::filesystem::path _path;
 
     u32 _width;
     u32 _height;
+    u32 _handle;
 
     SDL_Texture *_data;
+
+    // atlas page and position inside it, null when not atlased
+    const Texture2D *_page;
+    i32 _offset_x;
+    i32 _offset_y;
 };
 }  // namespace explore::core
 
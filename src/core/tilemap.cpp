@@ -7,15 +7,26 @@
 #include <string>
 
 #include "../core/file.h"
-#include "../core/rect.h"
 #include "../core/texture2d.h"
 #include "../ecs/components.h"
 #include "../ecs/ecs.h"
 
 namespace explore::core {
+u32 material_layer(TileMaterial material) {
+    switch (material) {
+        case TileMaterial::Water:
+            return layer::WATER;
+        case TileMaterial::Solid:
+            return layer::TERRAIN;
+        default:
+            return layer::NONE;
+    }
+}
+
 Tilemap::Tilemap(explore::ecs::Registry &registry, std::string name,
                  u32 tile_width, u32 tile_height, u32 tile_scale)
     : _entities(),
+      _materials(),
       _registry(registry),
       _name(name),
       _tile_width(tile_width),
@@ -32,7 +43,9 @@ Tilemap::~Tilemap() {
 }
 
 bool Tilemap::load(const std::filesystem::path &path,
-                   const Texture2D &texture) {
+                   const Texture2D &texture,
+                   const std::filesystem::path &materials_path,
+                   u32 fill_width, u32 fill_height) {
     ASSERT_RET_MSG(!_is_loaded && _entities.size() == 0, false,
                    "tilemap already loaded");
 
@@ -46,53 +59,62 @@ bool Tilemap::load(const std::filesystem::path &path,
     ASSERT_RET_MSG(tileset_cols > 0, _is_loaded,
                    "tileset columns is zero — check tile sizes");
 
+    // tiles are parsed straight into the grid, the whole map becomes one
+    // entity instead of one entity per tile
+    std::vector<u16> tiles;
     std::stringstream ss(file_contents);
     std::string line;
 
     u32 y = 0;
-    u32 x = 0;
+    u32 width = 0;
     while (std::getline(ss, line)) {
         std::stringstream line_stream(line);
         std::string value;
 
-        x = 0;
+        u32 x = 0;
         while (std::getline(line_stream, value, ',')) {
-            int tile_index = std::stoi(value);
-
-            if (tile_index >= 0) {
-                const u32 tile_col =
-                    static_cast<u32>(tile_index) % tileset_cols;
-                const u32 tile_row =
-                    static_cast<u32>(tile_index) / tileset_cols;
-
-                SDL_Rect src{core::rect(tile_col * _tile_width,
-                                        tile_row * _tile_height, _tile_width,
-                                        _tile_height)};
-
-                explore::ecs::Entity tile = _registry.create_entity();
-                tile.add_group(constants::TILE_GROUP);
-
-                glm::vec2 pos{
-                    static_cast<float>(x * _tile_width * _tile_scale),
-                    static_cast<float>(y * _tile_height * _tile_scale)};
-
-                glm::vec2 scale{static_cast<float>(_tile_scale),
-                                static_cast<float>(_tile_scale)};
-
-                tile.add_component<component::Transform>(pos, scale, 0.f);
-                tile.add_component<component::Sprite>(texture.get_name(), 0u,
-                                                      src);
-
-                _entities.push_back(tile);
-            }
-
+            const int tile_index = std::stoi(value);
+            ASSERT_RET_MSG(tile_index < component::Tilemap::empty_tile,
+                           _is_loaded, "tile index '%d' out of range",
+                           tile_index);
+
+            tiles.push_back(tile_index >= 0
+                                ? static_cast<u16>(tile_index)
+                                : component::Tilemap::empty_tile);
             ++x;
         }
 
+        if (y == 0) width = x;
+        // short rows are padded and long rows cut so the grid stays dense
+        if (x != width) {
+            spdlog::warn("tilemap '{}' row {} has {} tiles, expected {}",
+                         _name, y, x, width);
+            tiles.resize((y + 1) * width, component::Tilemap::empty_tile);
+        }
+
         ++y;
     }
-    _map_width = x;
+    _map_width = width;
     _map_height = y;
+
+    _materials.assign(_map_width * _map_height,
+                      static_cast<u8>(TileMaterial::None));
+    if (!materials_path.empty() && !_load_materials(materials_path)) {
+        spdlog::warn("tilemap '{}' has no materials, tiles will not collide",
+                     _name);
+    }
+
+    if (fill_width > 0 && fill_height > 0 && _map_width > 0 &&
+        _map_height > 0) {
+        _fill(tiles, fill_width, fill_height);
+    }
+
+    explore::ecs::Entity tilemap = _registry.create_entity(_name);
+    tilemap.add_component<component::Tilemap>(
+        texture.get_name(), _tile_width, _tile_height, _tile_scale,
+        tileset_cols, _map_width, _map_height, std::move(tiles));
+    _entities.push_back(tilemap);
+
     _is_loaded = true;
     spdlog::debug("tilemap '{}' loaded with '{}x{}' tiles from '{}'", _name,
                   _map_width, _map_height, path.string());
@@ -107,6 +129,7 @@ bool Tilemap::unload() {
     }
 
     _entities.clear();
+    _materials.clear();
     _map_width = 0;
     _map_height = 0;
     _is_loaded = false;
@@ -116,4 +139,54 @@ bool Tilemap::unload() {
     return true;
 }
 
+bool Tilemap::_load_materials(const std::filesystem::path &path) {
+    std::string file_contents;
+    if (!explore::file::read_all(path, file_contents)) {
+        spdlog::error("failed to read tilemap materials: {}", path.string());
+        return false;
+    }
+
+    std::stringstream ss(file_contents);
+    std::string line;
+
+    u32 y = 0;
+    while (std::getline(ss, line) && y < _map_height) {
+        std::stringstream line_stream(line);
+        std::string value;
+
+        u32 x = 0;
+        while (std::getline(line_stream, value, ',') && x < _map_width) {
+            const int material = std::stoi(value);
+            ASSERT_RET_MSG(material >= 0 && material <= 0xff, false,
+                           "invalid tile material '%d'", material);
+            _materials[y * _map_width + x] = static_cast<u8>(material);
+            ++x;
+        }
+
+        ++y;
+    }
+
+    spdlog::debug("tilemap '{}' materials loaded from '{}'", _name,
+                  path.string());
+    return true;
+}
+
+void Tilemap::_fill(std::vector<u16> &tiles, u32 width, u32 height) {
+    std::vector<u16> filled_tiles(width * height);
+    std::vector<u8> filled_materials(width * height);
+    for (u32 y = 0; y < height; ++y) {
+        const u32 source_row{(y % _map_height) * _map_width};
+        for (u32 x = 0; x < width; ++x) {
+            const u32 source{source_row + x % _map_width};
+            filled_tiles[y * width + x] = tiles[source];
+            filled_materials[y * width + x] = _materials[source];
+        }
+    }
+
+    tiles = std::move(filled_tiles);
+    _materials = std::move(filled_materials);
+    _map_width = width;
+    _map_height = height;
+}
+
 }  // namespace explore::core
@@ -16,6 +16,12 @@ class Entity;
 namespace explore::core {
 class Texture2D;
 
+/* what a tile is made of, stored as one byte per map cell */
+enum class TileMaterial : u8 { None = 0, Water = 1, Solid = 2 };
+
+// collision layer of a material, see explore::layer
+u32 material_layer(TileMaterial material);
+
 // TODO: make this mess a lot better, so many things not considered
 // multiple textures, multuple maps etc.
 class Tilemap {
@@ -37,12 +43,33 @@ class Tilemap {
         return _map_height * _tile_height * _tile_scale;
     }
 
-    bool load(const std::filesystem::path &path, const Texture2D &texture);
+    // size of a tile in world space
+    u32 scaled_tile_width() const { return _tile_width * _tile_scale; }
+    u32 scaled_tile_height() const { return _tile_height * _tile_scale; }
+
+    // material of the tile at x,y, cells outside the map have no material
+    TileMaterial material_at(i32 x, i32 y) const {
+        if (x < 0 || y < 0 || static_cast<u32>(x) >= _map_width ||
+            static_cast<u32>(y) >= _map_height || _materials.empty()) {
+            return TileMaterial::None;
+        }
+        return static_cast<TileMaterial>(_materials[y * _map_width + x]);
+    }
+
+    // materials_path is an optional csv of material ids with the same
+    // dimensions as the map, without it every tile has no material. with a
+    // fill size the map and its materials repeat to cover that many tiles
+    bool load(const std::filesystem::path &path, const Texture2D &texture,
+              const std::filesystem::path &materials_path = {},
+              u32 fill_width = 0, u32 fill_height = 0);
 
     bool unload();
 
    private:
+    // entity carrying the tile grid component
     std::vector<ecs::Entity> _entities;
+    // row major material grid, _map_width * _map_height bytes
+    std::vector<u8> _materials;
 
     explore::ecs::Registry &_registry;
 
@@ -56,6 +83,10 @@ class Tilemap {
     u32 _map_height;
 
     bool _is_loaded;
+
+   private:
+    bool _load_materials(const std::filesystem::path &path);
+    void _fill(std::vector<u16> &tiles, u32 width, u32 height);
 };
 
 }  // namespace explore::core
@@ -5,9 +5,11 @@
 #include <SDL_timer.h>
 #include <spdlog/spdlog.h>
 
+#include <atomic>
 #include <glm/fwd.hpp>
 #include <glm/glm.hpp>
 #include <string>
+#include <vector>
 
 #include "../common.h"
 
@@ -17,10 +19,20 @@ struct Transform {
     glm::vec2 position;
     glm::vec2 scale;
     f64 rotation;
+    // position before the last movement step
+    glm::vec2 previous_position;
 
     Transform(glm::vec2 position = {0, 0}, glm::vec2 scale = {1, 1},
               f64 rotation = 0.0)
-        : position(position), scale(scale), rotation(rotation) {}
+        : position(position),
+          scale(scale),
+          rotation(rotation),
+          previous_position(position) {}
+
+    // position between the last two movement steps, alpha in [0, 1]
+    glm::vec2 interpolated_position(f32 alpha) const {
+        return previous_position + (position - previous_position) * alpha;
+    }
 };
 
 struct RigidBody {
@@ -41,6 +53,77 @@ struct Sprite {
         : texture_name(texture_name), z_index(z_index), src_rect(src_rect) {}
 };
 
+// static tile grid drawn by the TilemapRender system. tiles are row major
+// indices into the tileset texture, two bytes per cell
+struct Tilemap {
+    static constexpr u16 empty_tile{0xffff};
+    // side of the square blocks of tiles the renderer bakes into one texture
+    static constexpr u32 chunk_size{16u};
+
+    std::string texture_name;
+
+    u32 tile_width;
+    u32 tile_height;
+    u32 tile_scale;
+    // tiles per row of the tileset texture
+    u32 tileset_columns;
+
+    u32 map_width;
+    u32 map_height;
+    std::vector<u16> tiles;
+    // chunks touched by set_tile since the renderer last looked, may repeat
+    std::vector<u32> edited_chunks;
+    // unique per constructed tilemap, copies keep the one of their source
+    u32 generation;
+    // bumped by every edit, copies of the same revision hold the same tiles
+    u32 revision;
+
+    Tilemap(std::string texture_name = "", u32 tile_width = 0,
+            u32 tile_height = 0, u32 tile_scale = 1, u32 tileset_columns = 1,
+            u32 map_width = 0, u32 map_height = 0, std::vector<u16> tiles = {})
+        : texture_name(texture_name),
+          tile_width(tile_width),
+          tile_height(tile_height),
+          tile_scale(tile_scale),
+          tileset_columns(tileset_columns),
+          map_width(map_width),
+          map_height(map_height),
+          tiles(std::move(tiles)),
+          edited_chunks(),
+          generation(next_generation()),
+          revision(0) {}
+
+    u16 tile_at(u32 x, u32 y) const { return tiles[y * map_width + x]; }
+
+    // edits should go through here so baked chunks get rebuilt
+    void set_tile(u32 x, u32 y, u16 tile) {
+        tiles[y * map_width + x] = tile;
+        edited_chunks.push_back((y / chunk_size) * chunk_columns() +
+                                x / chunk_size);
+        ++revision;
+    }
+
+    u32 chunk_columns() const {
+        return (map_width + chunk_size - 1) / chunk_size;
+    }
+    u32 chunk_rows() const {
+        return (map_height + chunk_size - 1) / chunk_size;
+    }
+
+    // source rect of tile inside the tileset texture
+    SDL_Rect src_rect(u16 tile) const {
+        return {static_cast<i32>((tile % tileset_columns) * tile_width),
+                static_cast<i32>((tile / tileset_columns) * tile_height),
+                static_cast<i32>(tile_width), static_cast<i32>(tile_height)};
+    }
+
+   private:
+    static u32 next_generation() {
+        static std::atomic<u32> generations{0};
+        return ++generations;
+    }
+};
+
 struct Animation {
     u32 num_frames;
     u32 current_frame;
@@ -61,8 +144,27 @@ struct BoxCollider {
     u32 height;
     glm::vec2 offset;
 
-    BoxCollider(u32 width = 0, u32 height = 0, glm::vec2 offset = glm::vec2(0))
-        : width(width), height(height), offset(offset) {}
+    // layer this collider lives on and the layers it interacts with
+    u32 layer;
+    u32 mask;
+
+    // sweep the collider along its movement each step so fast movers cannot
+    // tunnel through thin colliders at low tick rates
+    bool continuous;
+
+    BoxCollider(u32 width = 0, u32 height = 0, glm::vec2 offset = glm::vec2(0),
+                u32 layer = layer::DEFAULT, u32 mask = layer::ALL,
+                bool continuous = false)
+        : width(width),
+          height(height),
+          offset(offset),
+          layer(layer),
+          mask(mask),
+          continuous(continuous) {}
+
+    bool interacts_with(const BoxCollider &other) const {
+        return (layer & other.mask) != 0 && (other.layer & mask) != 0;
+    }
 };
 
 struct KeyboardControl {
@@ -4,6 +4,8 @@
 
 #include <algorithm>
 
+#include "../core/profiler.h"
+
 namespace explore::ecs {
 
 u32 BaseComponent::_next_id{0};
@@ -71,11 +73,14 @@ const Signature &System::get_comp_signature() const {
 //////////////////////////////////////
 
 void Registry::update() {
+    PROFILE_SCOPE("Registry::update");
     for (auto entity : _entities_add_queue) {
         add_entity_to_systems(entity);
     }
+    _created_count += _entities_add_queue.size();
     _entities_add_queue.clear();
 
+    _destroyed_count += _entities_kill_queue.size();
     for (auto entity : _entities_kill_queue) {
         const u32 id{entity.get_id()};
         remove_entity_from_systems(entity);
@@ -93,6 +98,10 @@ void Registry::update() {
     _entities_kill_queue.clear();
 }
 
+u32 Registry::get_entity_count() const {
+    return _entity_count - static_cast<u32>(_free_ids.size());
+}
+
 Entity Registry::create_entity() { return create_entity(default_entity_name); }
 
 Entity Registry::create_entity(const std::string_view entity_name) {
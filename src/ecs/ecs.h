@@ -137,6 +137,12 @@ class IPool {
    public:
     virtual ~IPool() = default;
     virtual void remove_entity_from_pool(u32 entity_id) = 0;
+
+    // components stored and slots allocated
+    virtual u32 size() const = 0;
+    virtual u32 capacity() const = 0;
+    // mangled name of the component type
+    virtual const char *type_name() const = 0;
 };
 
 template <typename T>
@@ -158,7 +164,11 @@ class Pool : public IPool {
 
     bool empty() const { return _size == 0u; }
 
-    u32 size() const { return _size; }
+    u32 size() const override { return _size; }
+
+    u32 capacity() const override { return static_cast<u32>(_data.size()); }
+
+    const char *type_name() const override { return typeid(T).name(); }
 
     void resize(u32 n) { _data.resize(n); }
 
@@ -230,6 +240,9 @@ class Registry {
     constexpr static const std::string_view default_entity_name = "default";
 
     u32 _entity_count{0};
+    // entities added to and removed from systems over the whole run
+    u64 _created_count{0};
+    u64 _destroyed_count{0};
 
     // each pool contains all data for a certain component type
     std::vector<std::shared_ptr<explore::ecs::IPool>> _comp_pools;
@@ -263,6 +276,16 @@ class Registry {
 
     void update();
 
+    // live entities, including the ones waiting to be added to systems
+    u32 get_entity_count() const;
+    u64 get_created_count() const { return _created_count; }
+    u64 get_destroyed_count() const { return _destroyed_count; }
+
+    // component pools indexed by component id, unused ids hold null
+    const std::vector<std::shared_ptr<IPool>> &get_pools() const {
+        return _comp_pools;
+    }
+
     Entity create_entity();
     Entity create_entity(const std::string_view name);
 
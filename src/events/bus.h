@@ -8,6 +8,8 @@
 #include <typeindex>
 #include <utility>
 
+#include "../common.h"
+#include "../core/profiler.h"
 #include "./event.h"
 
 namespace explore::event {
@@ -43,9 +45,18 @@ class Callback : public ICallback {
 
 typedef std::list<std::unique_ptr<ICallback>> HandlerList;
 
+// events of one type emitted since the counts were last reset
+struct EmitCount {
+    // mangled name of the event type
+    const char *type_name{nullptr};
+    u32 count{0};
+};
+
 class Bus {
    private:
     std::map<std::type_index, std::unique_ptr<HandlerList>> _subscribers;
+    // survives reset(), which only drops the subscribers
+    std::map<std::type_index, EmitCount> _emit_counts;
 
    public:
     Bus() = default;
@@ -53,6 +64,14 @@ class Bus {
 
     void reset() { _subscribers.clear(); }
 
+    const std::map<std::type_index, EmitCount> &get_emit_counts() const {
+        return _emit_counts;
+    }
+
+    void reset_emit_counts() {
+        for (auto &[type, emitted] : _emit_counts) emitted.count = 0;
+    }
+
     template <typename TEvent, typename TOwner>
     void on(TOwner *owner, void (TOwner::*callbackFunction)(TEvent &)) {
         if (!_subscribers[typeid(TEvent)].get()) {
@@ -67,6 +86,11 @@ class Bus {
 
     template <typename TEvent, typename... TArgs>
     void emit(TArgs &&...args) {
+        PROFILE_SCOPE("Bus::emit");
+        auto &emitted{_emit_counts[typeid(TEvent)]};
+        emitted.type_name = typeid(TEvent).name();
+        ++emitted.count;
+
         auto handlers = _subscribers[typeid(TEvent)].get();
         if (!handlers) return;
         for (auto it = handlers->begin(); it != handlers->end(); it++) {
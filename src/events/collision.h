@@ -13,6 +13,22 @@ struct Collision : public Event {
     Collision(ecs::Entity a, ecs::Entity b) : a(a), b(b) {}
 };
 
+// two colliders started overlapping this frame
+struct CollisionEnter : public Collision {
+    using Collision::Collision;
+};
+
+// two colliders are still overlapping, only emitted when enabled on the
+// collision system
+struct CollisionStay : public Collision {
+    using Collision::Collision;
+};
+
+// two colliders stopped overlapping. not emitted when one of them was killed
+struct CollisionExit : public Collision {
+    using Collision::Collision;
+};
+
 }  // namespace explore::event
 
 #endif  // EXPLORE_EVENTS_COLLISION_H_
@@ -0,0 +1,25 @@
+#ifndef EXPLORE_EVENTS_TILE_COLLISION_H_
+#define EXPLORE_EVENTS_TILE_COLLISION_H_
+
+#include "../core/tilemap.h"
+#include "../ecs/ecs.h"
+#include "./event.h"
+
+namespace explore::event {
+
+// a collider overlaps a tile whose material is part of its mask, emitted at
+// most once per collider per frame
+struct TileCollision : public Event {
+    ecs::Entity entity;
+    i32 tile_x;
+    i32 tile_y;
+    core::TileMaterial material;
+
+    TileCollision(ecs::Entity entity, i32 tile_x, i32 tile_y,
+                  core::TileMaterial material)
+        : entity(entity), tile_x(tile_x), tile_y(tile_y), material(material) {}
+};
+
+}  // namespace explore::event
+
+#endif  // EXPLORE_EVENTS_TILE_COLLISION_H_
@@ -1,17 +1,19 @@
 #include <spdlog/common.h>
 #include <spdlog/spdlog.h>
 
+#include <limits>
+#include <stdexcept>
 #include <string>
+#include <type_traits>
 
 #include "./common.h"
+#include "./core/profiler.h"
 #include "./managers/game_manager.h"
 
-void parse_argv(int argc, char **argv);
+explore::manager::GameOptions parse_argv(int argc, char **argv);
 
 i32 main(int argc, char **argv) {
-    parse_argv(argc, argv);
-
-    explore::manager::GameManager game_manager{};
+    explore::manager::GameManager game_manager{parse_argv(argc, argv)};
     if (!game_manager.initialize()) {
         return EXIT_FAILURE;
     }
@@ -19,8 +21,40 @@ i32 main(int argc, char **argv) {
     return EXIT_SUCCESS;
 }
 
-void parse_argv(int argc, char **argv) {
+// parses the value given to flag into out. a malformed or out of range value
+// is logged and leaves out at its default instead of throwing
+template <typename T>
+bool parse_number(const std::string &flag, const char *value, T &out) {
+    try {
+        std::size_t end{0};
+        T parsed{};
+        if constexpr (std::is_floating_point_v<T>) {
+            parsed = static_cast<T>(std::stod(value, &end));
+        } else {
+            const unsigned long long number{std::stoull(value, &end)};
+            if (number > std::numeric_limits<T>::max()) {
+                throw std::out_of_range(flag);
+            }
+            parsed = static_cast<T>(number);
+        }
+        if (value[end] != '\0') throw std::invalid_argument(flag);
+        out = parsed;
+        return true;
+    } catch (const std::logic_error &) {
+        spdlog::error("invalid value '{}' for {}, using the default", value,
+                      flag);
+        return false;
+    }
+}
+
+explore::manager::GameOptions parse_argv(int argc, char **argv) {
+    explore::manager::GameOptions options{};
     auto log_level{spdlog::level::debug};
+    std::string trace_path{};
+#ifdef EXPLORE_PROFILE
+    u32 trace_first{0};
+    u32 trace_last{299};
+#endif
     for (int i = 0; i < argc; i++) {
         std::string key{argv[i]};
 
@@ -28,8 +62,117 @@ void parse_argv(int argc, char **argv) {
             log_level = spdlog::level::from_str(argv[i + 1]);
             i++;
         }
+
+        // chrome trace of the simulated frames [first, last]
+        if (key == "--trace" && i + 1 < argc) {
+            trace_path = argv[i + 1];
+            i++;
+        }
+#ifdef EXPLORE_PROFILE
+        if (key == "--trace-frames" && i + 2 < argc) {
+            u32 first{0};
+            u32 last{0};
+            if (parse_number(key, argv[i + 1], first) &&
+                parse_number(key, argv[i + 2], last)) {
+                trace_first = first;
+                trace_last = last;
+            }
+            i += 2;
+        }
+#endif
+
+        if (key == "--stats" && i + 1 < argc) {
+            options.stats_path = argv[i + 1];
+            i++;
+        }
+
+        // frames over this many ms dump the flight recorder, 0 disables
+        if (key == "--hitch-ms" && i + 1 < argc) {
+            parse_number(key, argv[i + 1], options.hitch_threshold);
+            i++;
+        }
+        if (key == "--hitch-dir" && i + 1 < argc) {
+            options.hitch_directory = argv[i + 1];
+            i++;
+        }
+
+        // per system hardware counters, linux only
+        if (key == "--perf-counters") {
+            options.perf_counters = true;
+        }
+
+        // no window and no frame cap, for machines without a display
+        if (key == "--headless") {
+            options.headless = true;
+        }
+
+        // fixed simulation rate, e.g. 30 on a headless server
+        if (key == "--tick-rate" && i + 1 < argc) {
+            parse_number(key, argv[i + 1], options.tick_rate);
+            i++;
+        }
+        if (key == "--max-ticks" && i + 1 < argc) {
+            parse_number(key, argv[i + 1], options.max_ticks_per_frame);
+            i++;
+        }
+
+        // stress scenario, see StressOptions
+        if (key == "--frames" && i + 1 < argc) {
+            parse_number(key, argv[i + 1], options.frames);
+            i++;
+        }
+        if (key == "--stress" && i + 2 < argc) {
+            u32 tanks{0};
+            u32 trucks{0};
+            if (parse_number(key, argv[i + 1], tanks) &&
+                parse_number(key, argv[i + 2], trucks)) {
+                options.stress.tanks = tanks;
+                options.stress.trucks = trucks;
+            }
+            i += 2;
+        }
+        if (key == "--stress-map" && i + 2 < argc) {
+            u32 width{0};
+            u32 height{0};
+            if (parse_number(key, argv[i + 1], width) &&
+                parse_number(key, argv[i + 2], height)) {
+                options.stress.map_width = width;
+                options.stress.map_height = height;
+            }
+            i += 2;
+        }
+        if (key == "--stress-speed" && i + 1 < argc) {
+            parse_number(key, argv[i + 1], options.stress.max_speed);
+            i++;
+        }
+        if (key == "--seed" && i + 1 < argc) {
+            parse_number(key, argv[i + 1], options.stress.seed);
+            i++;
+        }
     }
 
     spdlog::set_level(log_level);
     spdlog::info("log level: {}", spdlog::level::to_string_view(log_level));
+
+    if (options.tick_rate == 0) {
+        spdlog::warn("--tick-rate must be at least 1, using {}",
+                     explore::constants::TICK_RATE);
+        options.tick_rate = explore::constants::TICK_RATE;
+    }
+    if (options.max_ticks_per_frame == 0) {
+        spdlog::warn("--max-ticks must be at least 1, using {}",
+                     explore::constants::MAX_TICKS_PER_FRAME);
+        options.max_ticks_per_frame = explore::constants::MAX_TICKS_PER_FRAME;
+    }
+
+    if (!trace_path.empty()) {
+#ifdef EXPLORE_PROFILE
+        explore::core::Profiler::configure(trace_path, trace_first,
+                                           trace_last);
+#else
+        spdlog::warn("--trace ignored, built without EXPLORE_PROFILE");
+#endif
+    }
+
+    return options;
 }
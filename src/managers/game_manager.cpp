@@ -4,7 +4,13 @@
 #include <SDL_timer.h>
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <thread>
+
 #include "../core/file.h"
+#include "../core/profiler.h"
 #include "../core/game_context.h"
 #include "../core/rect.h"
 #include "../core/tilemap.h"
@@ -20,22 +26,81 @@
 #include "../systems/projectile_emit.h"
 #include "../systems/projectile_lifecycle.h"
 #include "../systems/render.h"
+#include "../systems/tilemap_render.h"
 
 namespace explore::manager {
 
+template <typename TSystem, typename TFn>
+void GameManager::_run_system(const char *name,
+                              std::vector<core::SystemStats> &stats,
+                              const u32 entities, TFn &&fn) {
+    PROFILE_SCOPE(name);
+    TSystem &instance{_registry.get_system<TSystem>()};
+
+    const core::PerfSample before{core::PerfCounters::read()};
+    const u64 start{core::Profiler::now()};
+    fn(instance);
+    const u64 end{core::Profiler::now()};
+    const core::PerfSample after{core::PerfCounters::read()};
+    _flight_recorder.record(name, start, end);
+
+    // names are literals, so the pointer identifies the entry
+    auto entry{std::find_if(stats.begin(), stats.end(),
+                            [name](const core::SystemStats &s) {
+                                return s.name == name;
+                            })};
+    if (entry == stats.end()) {
+        stats.push_back({name, 0.0, 0, 0, {}});
+        entry = std::prev(stats.end());
+    }
+    entry->time += static_cast<f64>(end - start) / 1000000.0;
+    ++entry->calls;
+    entry->counters += after - before;
+    entry->entities = entities;
+}
+
+template <typename TSystem, typename TFn>
+void GameManager::_run_system(const char *name,
+                              std::vector<core::SystemStats> &stats,
+                              TFn &&fn) {
+    const TSystem &instance{_registry.get_system<TSystem>()};
+    _run_system<TSystem>(name, stats,
+                         static_cast<u32>(instance.get_entities().size()),
+                         std::forward<TFn>(fn));
+}
+
+GameManager::~GameManager() {
+    // baked tilemap chunks belong to the renderer, which goes away with the
+    // screen manager before the registry is destroyed
+    if (_registry.has_system<system::TilemapRender>()) {
+        _registry.get_system<system::TilemapRender>().invalidate();
+    }
+}
+
 bool GameManager::initialize() {
-    if (!_screen_manager.initialize()) {
+    if (!_screen_manager.initialize(_options.headless)) {
         return false;
     }
 
     _resource_manager.set_renderer(_screen_manager.get_renderer());
 
+    _flight_recorder.configure(_options.hitch_threshold,
+                               _options.hitch_directory);
+
+    // the game runs without the overlay if imgui fails, and there is no
+    // one to look at it headless
+    if (!_options.headless) {
+        _overlay_manager.initialize(_screen_manager.get_window(),
+                                    _screen_manager.get_renderer());
+    }
+
     auto dimensions{_screen_manager.get_dimensions()};
 
     _camera.x = 0;
     _camera.y = 0;
     _camera.w = dimensions.x;
     _camera.h = dimensions.y;
+    _previous_camera = _camera;
 
     // TODO instead of keeping track of window dimensions
     // multiple places, have a single source of truth
@@ -48,23 +113,148 @@ bool GameManager::initialize() {
 
 void GameManager::run() {
     _setup();
+    _snapshots.reset();
+
+    std::thread simulation(&GameManager::_simulate, this);
+
+    PROFILE_THREAD("render");
+    core::FlightRecorder::attach_thread(core::FlightRecorder::Track::Render);
+    if (_options.perf_counters) core::PerfCounters::open_thread();
     while (_running) {
         _process_input();
-        _update();
-        _render();
-        if (_game_context.sample_fps) {
-            spdlog::info("FPS: {}", _game_context.FPS());
+
+        core::RenderSnapshot *snapshot{nullptr};
+        {
+            PROFILE_SCOPE("wait for snapshot");
+            core::RecorderScope recorded(_flight_recorder, "wait for snapshot");
+            snapshot = _snapshots.begin_read();
+        }
+        if (snapshot == nullptr) break;
+        _render(*snapshot);
+        if (snapshot->sample_fps) {
+            const auto &sprites{snapshot->sprite_stats};
+            const auto &tiles{snapshot->tile_stats};
+            spdlog::info(
+                "FPS: {} frame: {:.2f}ms stddev: {:.3f}ms p99: {:.2f}ms "
+                "drawn: {} culled: {}",
+                snapshot->fps, snapshot->frame_time,
+                snapshot->frame_time_stddev, snapshot->frame_window.p99,
+                sprites.drawn + tiles.drawn, sprites.culled + tiles.culled);
         }
+        _snapshots.end_read();
     }
+
+    // the simulation may be waiting for a snapshot the loop no longer frees
+    _running = false;
+    _snapshots.stop();
+    simulation.join();
+
+    spdlog::info("frames: {} frame: {:.2f}ms stddev: {:.3f}ms",
+                 _game_context.run_frames(),
+                 _game_context.run_frame_time_mean(),
+                 _game_context.run_frame_time_stddev());
+    core::Profiler::write_trace();
+    if (_options.stress.enabled() || _options.frames > 0) _report();
+    if (!_options.stats_path.empty()) _frame_stats.write(_options.stats_path);
+    if (_options.perf_counters) _perf_totals.log();
+}
+
+void GameManager::_simulate() {
+    const f64 step{_game_context.tick_delta_time()};
+    f64 accumulator{0.0};
+
+    PROFILE_THREAD("simulation");
+    core::FlightRecorder::attach_thread(
+        core::FlightRecorder::Track::Simulation);
+    if (_options.perf_counters) core::PerfCounters::open_thread();
+
+    u64 frame_start{0};
+    u64 created{_registry.get_created_count()};
+    u64 destroyed{_registry.get_destroyed_count()};
+    _run_start = core::Profiler::now();
+    while (_running) {
+        if (_options.frames > 0 && _frame_count >= _options.frames) break;
+        ++_frame_count;
+
+        PROFILE_FRAME();
+        {
+            PROFILE_SCOPE("frame pacing");
+            core::RecorderScope recorded(_flight_recorder, "frame pacing");
+            _game_context.update_delta_time();
+        }
+        accumulator += _game_context.delta_time;
+
+        // a frame spans from one paced start to the next, like delta_time
+        const u64 now{core::Profiler::now()};
+        if (frame_start != 0) {
+            u32 events{0};
+            for (const auto &[type, emitted] : _event_bus.get_emit_counts()) {
+                events += emitted.count;
+            }
+            _flight_recorder.end_frame(
+                {frame_start, now, _registry.get_entity_count(),
+                 static_cast<u32>(_registry.get_created_count() - created),
+                 static_cast<u32>(_registry.get_destroyed_count() - destroyed),
+                 events});
+        }
+        frame_start = now;
+        created = _registry.get_created_count();
+        destroyed = _registry.get_destroyed_count();
+
+        _frame_stats.record_frame(_game_context.delta_time * 1000.0);
+        for (auto &stats : _system_stats) {
+            stats.time = 0.0;
+            stats.calls = 0;
+            stats.counters = {};
+        }
+        _event_bus.reset_emit_counts();
+
+        // the simulation advances in fixed steps however long the frame
+        // took, so its cost follows the tick rate and not the frame rate
+        u32 ticks{0};
+        while (accumulator >= step &&
+               ticks < _game_context.max_ticks_per_frame) {
+            PROFILE_SCOPE("tick");
+            _previous_camera = _camera;
+            _update(step);
+            accumulator -= step;
+            ++ticks;
+            _entity_ticks += _registry.get_entity_count();
+        }
+        _tick_count += ticks;
+        // time owed past the catch up limit is dropped, otherwise a slow
+        // frame makes the next one slower still
+        if (accumulator >= step) accumulator = std::fmod(accumulator, step);
+
+        core::RenderSnapshot *snapshot{nullptr};
+        {
+            PROFILE_SCOPE("wait for free snapshot");
+            core::RecorderScope recorded(_flight_recorder,
+                                         "wait for free snapshot");
+            snapshot = _snapshots.begin_write();
+        }
+        if (snapshot == nullptr) break;
+        // frames land between steps, draw that far between the last two
+        _extract(*snapshot, static_cast<f32>(accumulator / step));
+        _snapshots.end_write();
+    }
+    // the render loop stops with the simulation once the snapshots drain
+    _running = false;
+    _snapshots.stop();
 }
 
 void GameManager::_setup() {
-    _game_context.capped_frame_rate = true;
+    // headless runs are for measuring, so they go as fast as they can
+    _game_context.capped_frame_rate = !_options.headless;
     _game_context.sample_fps = false;
     _game_context.draw_collision_rects = true;
+    // set before the simulation thread reads the step length
+    _game_context.tick_rate = _options.tick_rate;
+    _game_context.max_ticks_per_frame = _options.max_ticks_per_frame;
 
     _registry.add_system<system::Movement>();
     _registry.add_system<system::Render>();
+    _registry.add_system<system::TilemapRender>();
     _registry.add_system<system::Animation>();
     _registry.add_system<system::Collision>();
     _registry.add_system<system::DebugRender>();
@@ -74,6 +264,8 @@ void GameManager::_setup() {
     _registry.add_system<system::ProjectileEmit>();
     _registry.add_system<system::ProjectileLifecycle>();
 
+    _registry.get_system<system::Collision>().set_job_pool(&_job_pool);
+
     _resource_manager.add_texture(
         "tank-tex", FPATH("assets", "images", "tank-panther-right.png"));
 
@@ -92,6 +284,10 @@ void GameManager::_setup() {
     _resource_manager.add_texture("jungle",
                                   FPATH("assets", "tilemaps", "jungle.png"));
 
+    // entity textures share pages so sprites batch across them
+    _resource_manager.build_atlas(
+        {"tank-tex", "truck-tex", "chopper-tex", "radar-tex", "bullet-tex"});
+
     _resource_manager.add_tilemap(_registry, "tilemap", 32u, 32u, 3u);
 
     _load_level(1u);
@@ -99,22 +295,38 @@ void GameManager::_setup() {
 
 void GameManager::_load_level(const u32 level) {
     _resource_manager.load_tilemap(
-        "tilemap", FPATH("assets", "tilemaps", "jungle.map"), "jungle");
+        "tilemap", FPATH("assets", "tilemaps", "jungle.map"), "jungle",
+        FPATH("assets", "tilemaps", "jungle.materials"),
+        _options.stress.map_width, _options.stress.map_height);
 
     auto map_size{_resource_manager.loaded_tilemap_dimensions()};
 
     _game_context.map_width = map_size.x;
     _game_context.map_height = map_size.y;
 
+    // broadphase cells match the scaled tile size of the loaded map and
+    // colliders are tested against its material grid
+    auto opt_tilemap{_resource_manager.get_tilemap("tilemap")};
+    if (opt_tilemap.has_value()) {
+        const core::Tilemap &tilemap{opt_tilemap->get()};
+        auto &collision{_registry.get_system<system::Collision>()};
+        collision.set_cell_size(tilemap.scaled_tile_width());
+        collision.set_tilemap(&tilemap);
+    }
+
+    // the outer ring of tiles is solid and stops projectiles, so everything
+    // starts one scaled tile inside it
     ecs::Entity chopper{_registry.create_entity("chopper")};
     chopper.add_tag(constants::PLAYER_TAG);
-    chopper.add_component<component::Transform>(glm::vec2(10.f, 10.f),
+    chopper.add_component<component::Transform>(glm::vec2(106.f, 106.f),
                                                 glm::vec2(1.f, 1.f), 0.f);
     chopper.add_component<component::RigidBody>(glm::vec2(0.f, 0.f));
     chopper.add_component<component::Sprite>("chopper-tex", 1u,
                                              core::rect(0, 0, 32, 32));
     chopper.add_component<component::Animation>(2u, 15u, true);
-    chopper.add_component<component::BoxCollider>(32u, 32u);
+    chopper.add_component<component::BoxCollider>(
+        32u, 32u, glm::vec2(0), layer::PLAYER,
+        layer::ENEMY | layer::ENEMY_PROJECTILE);
 
     chopper.add_component<component::KeyboardControl>(
         glm::vec2(0, -50), glm::vec2(50, 0), glm::vec2(0, 50),
@@ -133,56 +345,138 @@ void GameManager::_load_level(const u32 level) {
                                            core::rect(0, 0, 64, 64));
     radar.add_component<component::Animation>(8u, 5u, true);
 
+    if (_options.stress.enabled()) {
+        _spawn_stress();
+        return;
+    }
+
+    // enemies ignore the tilemap, masking tile layers would only emit tile
+    // collisions nothing handles
     ecs::Entity tank{_registry.create_entity("tank")};
     tank.add_group(constants::ENEMY_GROUP);
-    tank.add_component<component::Transform>(glm::vec2(250.f, 10.f),
+    tank.add_component<component::Transform>(glm::vec2(250.f, 106.f),
                                              glm::vec2(2.f, 2.f), 0.f);
     tank.add_component<component::RigidBody>(glm::vec2(0.f, 0.f));
     tank.add_component<component::Sprite>("tank-tex", 2u,
                                           core::rect(0, 0, 32, 32));
-    tank.add_component<component::BoxCollider>(32u, 32u);
+    tank.add_component<component::BoxCollider>(
+        32u, 32u, glm::vec2(0), layer::ENEMY,
+        layer::PLAYER | layer::PLAYER_PROJECTILE);
     tank.add_component<component::ProjectileEmitter>(glm::vec2(100.0, 0.0),
                                                      5000u, 3000u, 10u, false);
     tank.add_component<component::Health>(100u);
 
     ecs::Entity truck{_registry.create_entity("truck")};
     truck.add_group(constants::ENEMY_GROUP);
-    truck.add_component<component::Transform>(glm::vec2(10.f, 10.f),
+    truck.add_component<component::Transform>(glm::vec2(106.f, 106.f),
                                               glm::vec2(1.f, 1.f), 0.f);
     truck.add_component<component::RigidBody>(glm::vec2(0.f, 0.f));
     truck.add_component<component::Sprite>("truck-tex", 2u,
                                            core::rect(0, 0, 32, 32));
-    truck.add_component<component::BoxCollider>(32u, 32u);
+    truck.add_component<component::BoxCollider>(
+        32u, 32u, glm::vec2(0), layer::ENEMY,
+        layer::PLAYER | layer::PLAYER_PROJECTILE);
     truck.add_component<component::ProjectileEmitter>(glm::vec2(0, 100.0),
                                                       2000u, 5000u, 10u, false);
     truck.add_component<component::Health>(100u);
 }
 
+void GameManager::_spawn_stress() {
+    const StressOptions &stress{_options.stress};
+    std::mt19937 rng{stress.seed};
+    std::uniform_real_distribution<f32> x(
+        0.f, static_cast<f32>(_game_context.map_width));
+    std::uniform_real_distribution<f32> y(
+        0.f, static_cast<f32>(_game_context.map_height));
+    std::uniform_real_distribution<f32> speed(-stress.max_speed,
+                                              stress.max_speed);
+    std::uniform_int_distribution<u32> interval(1000u, 5000u);
+
+    const auto spawn{[&](const char *name, const char *texture, f32 scale) {
+        ecs::Entity enemy{_registry.create_entity(name)};
+        enemy.add_group(constants::ENEMY_GROUP);
+        enemy.add_component<component::Transform>(
+            glm::vec2(x(rng), y(rng)), glm::vec2(scale, scale), 0.f);
+        enemy.add_component<component::RigidBody>(
+            glm::vec2(speed(rng), speed(rng)));
+        enemy.add_component<component::Sprite>(texture, 2u,
+                                               core::rect(0, 0, 32, 32));
+        enemy.add_component<component::BoxCollider>(
+            32u, 32u, glm::vec2(0), layer::ENEMY,
+            layer::PLAYER | layer::PLAYER_PROJECTILE);
+        enemy.add_component<component::ProjectileEmitter>(
+            glm::vec2(speed(rng), speed(rng)), interval(rng), 3000u, 10u,
+            false);
+        enemy.add_component<component::Health>(100u);
+    }};
+
+    for (u32 i = 0; i < stress.tanks; ++i) spawn("tank", "tank-tex", 2.f);
+    for (u32 i = 0; i < stress.trucks; ++i) spawn("truck", "truck-tex", 1.f);
+
+    spdlog::info("stress: {} tanks and {} trucks on a {}x{}px map, seed {}",
+                 stress.tanks, stress.trucks, _game_context.map_width,
+                 _game_context.map_height, stress.seed);
+}
+
+void GameManager::_report() const {
+    const f64 seconds{
+        static_cast<f64>(core::Profiler::now() - _run_start) / 1e9};
+    ASSERT_RET_V(seconds > 0.0);
+
+    spdlog::info("ran {} frames and {} ticks in {:.2f}s", _frame_count,
+                 _tick_count, seconds);
+    spdlog::info("{:.0f} entities/sec, {:.1f} ticks/sec",
+                 static_cast<f64>(_entity_ticks) / seconds,
+                 static_cast<f64>(_tick_count) / seconds);
+
+    const core::TimingSummary frame{
+        core::TimingSeries::summarize(_frame_stats.frame().total())};
+    spdlog::info("frame ms: mean {:.3f} p50 {:.3f} p95 {:.3f} p99 {:.3f} "
+                 "max {:.3f}",
+                 frame.mean, frame.p50, frame.p95, frame.p99, frame.max);
+
+    // cost per frame the system ran in
+    spdlog::info("{:<24} {:>8} {:>8} {:>8} {:>8}", "system ms", "mean", "p50",
+                 "p99", "max");
+    for (const core::TimingSeries &series : _frame_stats.systems()) {
+        const core::TimingSummary system{
+            core::TimingSeries::summarize(series.total())};
+        spdlog::info("{:<24} {:>8.3f} {:>8.3f} {:>8.3f} {:>8.3f}",
+                     series.name(), system.mean, system.p50, system.p99,
+                     system.max);
+    }
+}
+
 void GameManager::_process_input() {
+    PROFILE_SCOPE("GameManager::process_input");
     while (SDL_PollEvent(&_sdl_event)) {
+        _overlay_manager.process_event(_sdl_event);
         switch (_sdl_event.type) {
             case SDL_QUIT:
                 _running = false;
                 break;
-            case SDL_KEYDOWN:
-                if (_sdl_event.key.keysym.sym == SDLK_d) {
-                    _game_context.draw_collision_rects =
-                        !_game_context.draw_collision_rects;
+            case SDL_RENDER_TARGETS_RESET:
+            case SDL_RENDER_DEVICE_RESET:
+                _registry.get_system<system::TilemapRender>().invalidate();
+                break;
+            case SDL_KEYDOWN: {
+                if (_sdl_event.key.keysym.sym == SDLK_F1) {
+                    _overlay_manager.toggle();
                 }
                 if (_sdl_event.key.keysym.sym == SDLK_ESCAPE) {
                     _running = false;
                 }
-                _event_bus.emit<event::KeyPressed>(_sdl_event.key.keysym.sym);
+                std::lock_guard<std::mutex> lock(_input_mutex);
+                _pending_keys.push_back(_sdl_event.key.keysym.sym);
                 break;
+            }
             default:
                 break;
         }
     }
 }
 
-void GameManager::_update() {
-    _game_context.update_delta_time();
-
+void GameManager::_update(const f64 delta_time) {
     // TODO: rethink this reset stuff, introduce
     // maybe both "on", "off" and "once" listeners
     _event_bus.reset();
@@ -192,29 +486,151 @@ void GameManager::_update() {
     _registry.get_system<system::ProjectileEmit>().subscribe_to_events(
         _event_bus);
 
-    _registry.get_system<system::Movement>().update(_game_context.delta_time);
-    _registry.get_system<system::Animation>().update();
-    _registry.get_system<system::Collision>().update(_event_bus);
-    _registry.get_system<system::ProjectileEmit>().update(_registry);
-    _registry.get_system<system::ProjectileLifecycle>().update();
-    _registry.get_system<system::CameraMovement>().update(_camera,
-                                                          _game_context);
+    {
+        std::lock_guard<std::mutex> lock(_input_mutex);
+        _keys.swap(_pending_keys);
+    }
+    for (const SDL_Keycode key : _keys) {
+        if (key == SDLK_d) {
+            _game_context.draw_collision_rects =
+                !_game_context.draw_collision_rects;
+        }
+        _event_bus.emit<event::KeyPressed>(key);
+    }
+    _keys.clear();
+
+    _run_system<system::Movement>(
+        "Movement", _system_stats,
+        [&](system::Movement &movement) { movement.update(delta_time); });
+    _run_system<system::Animation>(
+        "Animation", _system_stats,
+        [](system::Animation &animation) { animation.update(); });
+    _run_system<system::Collision>(
+        "Collision", _system_stats,
+        [&](system::Collision &collision) { collision.update(_event_bus); });
+    _run_system<system::ProjectileEmit>(
+        "ProjectileEmit", _system_stats,
+        [&](system::ProjectileEmit &emit) { emit.update(_registry); });
+    _run_system<system::ProjectileLifecycle>(
+        "ProjectileLifecycle", _system_stats,
+        [](system::ProjectileLifecycle &lifecycle) { lifecycle.update(); });
+    _run_system<system::CameraMovement>(
+        "CameraMovement", _system_stats,
+        [&](system::CameraMovement &camera) {
+            camera.update(_camera, _game_context);
+        });
 
     _registry.update();
 }
 
-void GameManager::_render() {
-    _screen_manager.set_draw_color(color::black);
-    _screen_manager.clear();
+void GameManager::_extract(core::RenderSnapshot &snapshot, const f32 alpha) {
+    PROFILE_SCOPE("GameManager::extract");
 
-    _registry.get_system<system::Render>().update(_screen_manager,
-                                                  _resource_manager, _camera);
+    // render times of the frame this snapshot held last
+    for (const core::SystemStats &stats : snapshot.render_systems) {
+        if (stats.calls > 0) _record_system(stats);
+    }
+    snapshot.camera = _camera;
+    snapshot.camera.x = static_cast<i32>(std::lround(
+        _previous_camera.x + (_camera.x - _previous_camera.x) * alpha));
+    snapshot.camera.y = static_cast<i32>(std::lround(
+        _previous_camera.y + (_camera.y - _previous_camera.y) * alpha));
+
+    _run_system<system::TilemapRender>(
+        "TilemapRender::extract", _system_stats,
+        [&](system::TilemapRender &tilemaps) {
+            tilemaps.extract(snapshot, _resource_manager);
+        });
+    _run_system<system::Render>(
+        "Render::extract", _system_stats, [&](system::Render &render) {
+            render.extract(snapshot, _resource_manager, alpha);
+        });
 
     if (_game_context.draw_collision_rects) {
-        _registry.get_system<system::DebugRender>().update(_screen_manager);
+        _run_system<system::DebugRender>(
+            "DebugRender::extract", _system_stats,
+            [&](system::DebugRender &debug) {
+                debug.extract(snapshot, alpha);
+            });
+    } else {
+        snapshot.debug_rects.clear();
+    }
+
+    snapshot.delta_time = _game_context.delta_time * 1000.0;
+    snapshot.entities = _registry.get_entity_count();
+    snapshot.tilemap_entities = static_cast<u32>(
+        _registry.get_system<system::TilemapRender>().get_entities().size());
+    snapshot.sprite_entities = static_cast<u32>(
+        _registry.get_system<system::Render>().get_entities().size());
+    snapshot.debug_entities = static_cast<u32>(
+        _registry.get_system<system::DebugRender>().get_entities().size());
+    snapshot.systems = _system_stats;
+    for (const core::SystemStats &stats : _system_stats) {
+        if (stats.calls > 0) _record_system(stats);
+    }
+    snapshot.frame_window =
+        core::TimingSeries::summarize(_frame_stats.frame().window());
+
+    snapshot.pools.clear();
+    for (const auto &pool : _registry.get_pools()) {
+        if (!pool) continue;
+        snapshot.pools.push_back(
+            {pool->type_name(), pool->size(), pool->capacity()});
+    }
+
+    snapshot.events.clear();
+    for (const auto &[type, emitted] : _event_bus.get_emit_counts()) {
+        snapshot.events.push_back({emitted.type_name, emitted.count});
     }
 
-    _screen_manager.present();
+    snapshot.sample_fps = _game_context.sample_fps;
+    snapshot.fps = _game_context.FPS();
+    snapshot.frame_time = _game_context.frame_time_mean();
+    snapshot.frame_time_stddev = _game_context.frame_time_stddev();
+}
+
+void GameManager::_record_system(const core::SystemStats &stats) {
+    _frame_stats.record(stats.name, stats.time);
+    if (_options.perf_counters) {
+        _perf_totals.add(stats.name, stats.counters, stats.entity_visits());
+    }
 }
-}  // namespace explore::manager
 
+void GameManager::_render(core::RenderSnapshot &snapshot) {
+    _screen_manager.set_draw_color(color::black);
+    _screen_manager.clear();
+
+    for (auto &stats : _render_system_stats) {
+        stats.time = 0.0;
+        stats.calls = 0;
+        stats.counters = {};
+    }
+
+    // the entity lists belong to the simulation, their sizes come with the
+    // snapshot
+    _run_system<system::TilemapRender>(
+        "TilemapRender::submit", _render_system_stats,
+        snapshot.tilemap_entities, [&](system::TilemapRender &tilemaps) {
+            tilemaps.submit(_screen_manager, snapshot);
+        });
+    _run_system<system::Render>(
+        "Render::submit", _render_system_stats, snapshot.sprite_entities,
+        [&](system::Render &render) {
+            render.submit(_screen_manager, snapshot);
+        });
+    _run_system<system::DebugRender>(
+        "DebugRender::submit", _render_system_stats,
+        snapshot.debug_entities, [&](system::DebugRender &debug) {
+            debug.submit(_screen_manager, snapshot);
+        });
+
+    _overlay_manager.draw(snapshot, _render_system_stats);
+    snapshot.render_systems = _render_system_stats;
+
+    {
+        PROFILE_SCOPE("present");
+        core::RecorderScope recorded(_flight_recorder, "present");
+        _screen_manager.present();
+    }
+}
+}  // namespace explore::manager
@@ -3,29 +3,108 @@
 
 #include <SDL2/SDL_events.h>
 
+#include <atomic>
+#include <filesystem>
+#include <mutex>
+#include <utility>
+#include <vector>
+
 #include "../common.h"
+#include "../core/flight_recorder.h"
+#include "../core/frame_stats.h"
 #include "../core/game_context.h"
+#include "../core/job_pool.h"
+#include "../core/snapshot_queue.h"
 #include "../ecs/ecs.h"
 #include "../events/bus.h"
+#include "./overlay_manager.h"
 #include "./resource_manager.h"
 #include "./screen_manager.h"
 
 namespace explore::manager {
+// generated load for finding where the engine stops scaling. when any count
+// is set these enemies are spawned in place of the hand placed ones
+struct StressOptions {
+    u32 tanks{0};
+    u32 trucks{0};
+    // map size in tiles, the map file repeats to fill it. zero keeps the
+    // size of the file
+    u32 map_width{0};
+    u32 map_height{0};
+    u32 seed{1};
+    // largest speed along each axis in px/s
+    f32 max_speed{100.f};
+
+    bool enabled() const { return tanks > 0 || trucks > 0; }
+};
+
+// launch settings, mostly from the command line
+struct GameOptions {
+    // frame statistics are written here at exit, csv unless it ends in .json
+    std::filesystem::path stats_path;
+    // frames longer than this many ms dump the flight recorder, 0 disables
+    f64 hitch_threshold{30.0};
+    std::filesystem::path hitch_directory{"hitches"};
+    // count cycles, cache and branch misses per system, linux only
+    bool perf_counters{false};
+    // render offscreen with the software renderer, without a window
+    bool headless{false};
+    // simulated frames to run before quitting, 0 runs until quit
+    u32 frames{0};
+    // fixed simulation steps per second and how many a frame may run to
+    // catch up, both at least 1
+    u32 tick_rate{constants::TICK_RATE};
+    u32 max_ticks_per_frame{constants::MAX_TICKS_PER_FRAME};
+    StressOptions stress;
+};
+
+// the simulation runs on its own thread and hands a render snapshot per frame
+// to the main thread, which owns the window and renderer as sdl requires and
+// draws the previous frame while the next one is simulated
 class GameManager {
    private:
-    bool _running;
+    GameOptions _options;
+    std::atomic<bool> _running;
     SDL_Event _sdl_event;
     SDL_Rect _camera;
+    // camera before the last simulation step, for interpolation
+    SDL_Rect _previous_camera;
+
+    // keys pressed on the main thread, drained by the next update
+    std::mutex _input_mutex;
+    std::vector<SDL_Keycode> _pending_keys;
+    std::vector<SDL_Keycode> _keys;
 
     core::GameContext _game_context;
+    core::JobPool _job_pool;
     ecs::Registry _registry;
     event::Bus _event_bus;
     manager::ScreenManager _screen_manager;
     manager::ResourceManager _resource_manager;
+    // destroyed before the screen manager takes the renderer with it
+    manager::OverlayManager _overlay_manager;
+
+    core::SnapshotQueue _snapshots;
+    // times of the current frame, on the simulation and the main thread
+    std::vector<core::SystemStats> _system_stats;
+    std::vector<core::SystemStats> _render_system_stats;
+    // percentiles of the frame and system times, simulation side
+    core::FrameStats _frame_stats;
+    // last few seconds of scope timings, dumped when a frame hitches
+    core::FlightRecorder _flight_recorder;
+    core::PerfTotals _perf_totals;
+
+    // totals of the run for the report, simulation side
+    u64 _frame_count{0};
+    u64 _tick_count{0};
+    // entities alive summed over every tick
+    u64 _entity_ticks{0};
+    u64 _run_start{0};
 
    public:
-    GameManager() = default;
-    ~GameManager() = default;
+    explicit GameManager(GameOptions options = {})
+        : _options(std::move(options)) {}
+    ~GameManager();
 
     bool initialize();
     void run();
@@ -33,9 +112,28 @@ class GameManager {
    private:
     void _setup();
     void _load_level(u32 level);
+    // spawns the enemies of the stress scenario at random over the map
+    void _spawn_stress();
+    // logs throughput, frame percentiles and per system cost of the run
+    void _report() const;
+    void _simulate();
     void _process_input();
-    void _update();
-    void _render();
+    void _update(f64 delta_time);
+    void _extract(core::RenderSnapshot &snapshot, f32 alpha);
+    // adds the frame of a system to the run totals
+    void _record_system(const core::SystemStats &stats);
+
+    // calls fn with the system under a profiler scope, adds the time it
+    // took to the stats of this frame and to the flight recorder. entities
+    // is how many the system went through
+    template <typename TSystem, typename TFn>
+    void _run_system(const char *name, std::vector<core::SystemStats> &stats,
+                     u32 entities, TFn &&fn);
+    // counts the entities of the system itself, simulation thread only
+    template <typename TSystem, typename TFn>
+    void _run_system(const char *name, std::vector<core::SystemStats> &stats,
+                     TFn &&fn);
+    void _render(core::RenderSnapshot &snapshot);
 };
 
 }  // namespace explore::manager
@@ -0,0 +1,165 @@
+#include "overlay_manager.h"
+
+#include <imgui.h>
+#include <imgui_impl_sdl2.h>
+#include <imgui_impl_sdlrenderer2.h>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+
+#if defined(__GNUG__)
+#include <cxxabi.h>
+
+#include <cstdlib>
+#endif
+
+namespace explore::manager {
+
+OverlayManager::OverlayManager()
+    : _renderer(nullptr),
+      _initialized(false),
+      _visible(false),
+      _frame_times(),
+      _frame_index(0),
+      _type_names() {}
+
+OverlayManager::~OverlayManager() {
+    if (!_initialized) return;
+    ImGui_ImplSDLRenderer2_Shutdown();
+    ImGui_ImplSDL2_Shutdown();
+    ImGui::DestroyContext();
+}
+
+bool OverlayManager::initialize(SDL_Window *window, SDL_Renderer *renderer) {
+    ASSERT_RET_MSG(window && renderer, false, "window or renderer is null");
+
+    IMGUI_CHECKVERSION();
+    ImGui::CreateContext();
+    ImGui::GetIO().IniFilename = nullptr;
+    ImGui::StyleColorsDark();
+
+    if (!ImGui_ImplSDL2_InitForSDLRenderer(window, renderer) ||
+        !ImGui_ImplSDLRenderer2_Init(renderer)) {
+        spdlog::error("failed to initialize imgui");
+        ImGui::DestroyContext();
+        return false;
+    }
+
+    _renderer = renderer;
+    _initialized = true;
+    return true;
+}
+
+void OverlayManager::process_event(const SDL_Event &event) {
+    if (_initialized) ImGui_ImplSDL2_ProcessEvent(&event);
+}
+
+void OverlayManager::draw(
+    const core::RenderSnapshot &snapshot,
+    const std::vector<core::SystemStats> &render_systems) {
+    _frame_times[_frame_index % _graph_samples] =
+        static_cast<f32>(snapshot.delta_time);
+    ++_frame_index;
+
+    if (!_initialized || !_visible) return;
+
+    ImGui_ImplSDLRenderer2_NewFrame();
+    ImGui_ImplSDL2_NewFrame();
+    ImGui::NewFrame();
+
+    ImGui::SetNextWindowPos(ImVec2(8, 8), ImGuiCond_FirstUseEver);
+    ImGui::SetNextWindowBgAlpha(0.8f);
+    ImGui::Begin("performance", &_visible,
+                 ImGuiWindowFlags_AlwaysAutoResize);
+
+    // the graph reads the ring oldest first
+    const u32 offset{_frame_index < _graph_samples
+                         ? 0
+                         : _frame_index % _graph_samples};
+    const std::string frame_label{
+        fmt::format("{:.2f} ms", snapshot.delta_time)};
+    ImGui::PlotLines("frame", _frame_times.data(),
+                     static_cast<i32>(_graph_samples),
+                     static_cast<i32>(offset), frame_label.c_str(), 0.f,
+                     33.f, ImVec2(240, 60));
+
+    const core::TimingSummary &window{snapshot.frame_window};
+    ImGui::Text("p50 %.2f  p95 %.2f  p99 %.2f  max %.2f ms", window.p50,
+                window.p95, window.p99, window.max);
+
+    const u32 draw_calls{snapshot.sprite_stats.batches +
+                         snapshot.tile_stats.batches +
+                         static_cast<u32>(snapshot.debug_rects.size())};
+    ImGui::Text("draw calls: %u", draw_calls);
+    ImGui::Text("sprites drawn: %u culled: %u", snapshot.sprite_stats.drawn,
+                snapshot.sprite_stats.culled);
+    ImGui::Text("tiles drawn: %u culled: %u", snapshot.tile_stats.drawn,
+                snapshot.tile_stats.culled);
+    ImGui::Text("entities: %u", snapshot.entities);
+
+    _draw_systems("simulation", snapshot.systems);
+    _draw_systems("render", render_systems);
+
+    if (ImGui::CollapsingHeader("pools")) {
+        for (const core::PoolStats &pool : snapshot.pools) {
+            ImGui::Text("%-24s %6u / %6u", _type_name(pool.type_name).c_str(),
+                        pool.size, pool.capacity);
+        }
+    }
+
+    if (ImGui::CollapsingHeader("events", ImGuiTreeNodeFlags_DefaultOpen)) {
+        for (const core::EventStats &event : snapshot.events) {
+            ImGui::Text("%-24s %6u", _type_name(event.type_name).c_str(),
+                        event.count);
+        }
+    }
+
+    ImGui::End();
+    ImGui::Render();
+#if IMGUI_VERSION_NUM >= 19060
+    ImGui_ImplSDLRenderer2_RenderDrawData(ImGui::GetDrawData(), _renderer);
+#else
+    ImGui_ImplSDLRenderer2_RenderDrawData(ImGui::GetDrawData());
+#endif
+}
+
+void OverlayManager::_draw_systems(
+    const char *label, const std::vector<core::SystemStats> &systems) {
+    if (!ImGui::CollapsingHeader(label, ImGuiTreeNodeFlags_DefaultOpen)) {
+        return;
+    }
+    for (const core::SystemStats &system : systems) {
+        ImGui::Text("%-24s %7.3f ms %6u", system.name, system.time,
+                    system.entities);
+        // hardware counters are only there when they were opened
+        const core::PerfSample &counters{system.counters};
+        if (counters.cycles == 0) continue;
+        const f64 entities{
+            std::max(static_cast<f64>(system.entity_visits()), 1.0)};
+        ImGui::SameLine();
+        ImGui::Text(" ipc %.2f  l1 %.1f  llc %.1f  br %.1f /entity",
+                    counters.ipc(), counters.l1_misses / entities,
+                    counters.llc_misses / entities,
+                    counters.branch_misses / entities);
+    }
+}
+
+const std::string &OverlayManager::_type_name(const char *mangled) {
+    auto name{_type_names.find(mangled)};
+    if (name != _type_names.end()) return name->second;
+
+    std::string demangled{mangled};
+#if defined(__GNUG__)
+    i32 status{0};
+    char *result{abi::__cxa_demangle(mangled, nullptr, nullptr, &status)};
+    if (status == 0 && result != nullptr) demangled = result;
+    std::free(result);
+#endif
+    // namespaces only make the table wider
+    const auto scope{demangled.rfind("::")};
+    if (scope != std::string::npos) demangled = demangled.substr(scope + 2);
+
+    return _type_names.emplace(mangled, std::move(demangled)).first->second;
+}
+
+}  // namespace explore::manager
@@ -0,0 +1,62 @@
+#ifndef EXPLORE_MANAGERS_OVERLAY_MANAGER_H
+#define EXPLORE_MANAGERS_OVERLAY_MANAGER_H
+
+#include <SDL2/SDL_events.h>
+#include <SDL2/SDL_render.h>
+#include <SDL2/SDL_video.h>
+
+#include <array>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../common.h"
+#include "../core/render_snapshot.h"
+
+namespace explore::manager {
+
+// imgui window with the numbers of the last frame: system times and entity
+// counts, a frame time graph, component pool occupancy, emitted events and
+// draw calls. lives on the thread owning the renderer
+class OverlayManager {
+   private:
+    static constexpr u32 _graph_samples{240};
+
+    SDL_Renderer *_renderer;
+    bool _initialized;
+    bool _visible;
+
+    // frame times in ms, oldest first once wrapped
+    std::array<f32, _graph_samples> _frame_times;
+    u32 _frame_index;
+
+    // demangled and shortened type names
+    std::unordered_map<const char *, std::string> _type_names;
+
+   private:
+    const std::string &_type_name(const char *mangled);
+
+    void _draw_systems(const char *label,
+                       const std::vector<core::SystemStats> &systems);
+
+   public:
+    OverlayManager();
+    ~OverlayManager();
+
+    bool initialize(SDL_Window *window, SDL_Renderer *renderer);
+
+    bool is_visible() const { return _visible; }
+    void toggle() { _visible = !_visible; }
+
+    // forwards input to imgui
+    void process_event(const SDL_Event &event);
+
+    // records the frame and, if visible, draws the overlay on top of it.
+    // call after everything else is drawn and before present
+    void draw(const core::RenderSnapshot &snapshot,
+              const std::vector<core::SystemStats> &render_systems);
+};
+
+}  // namespace explore::manager
+
+#endif  // EXPLORE_MANAGERS_OVERLAY_MANAGER_H
@@ -1,11 +1,15 @@
 #include "resource_manager.h"
 
+#include <SDL_image.h>
 #include <SDL_render.h>
+#include <SDL_surface.h>
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
 #include <optional>
 #include <string>
 
+#include "../core/profiler.h"
 #include "../core/texture2d.h"
 #include "../core/tilemap.h"
 #include "./screen_manager.h"
@@ -13,11 +17,17 @@
 namespace explore::manager {
 
 ResourceManager::ResourceManager()
-    : _textures(), _renderer(nullptr), _loaded_tilemap("") {}
+    : _textures(),
+      _tilemaps(),
+      _atlas_pages(),
+      _renderer(nullptr),
+      _next_texture_handle(0),
+      _loaded_tilemap("") {}
 
 ResourceManager::~ResourceManager() {
     spdlog::trace("clearing all resources");
     _textures.clear();
+    _atlas_pages.clear();
     if (has_loaded_tilemap()) {
         unload_tilemap(_loaded_tilemap);
     }
@@ -30,6 +40,7 @@ void ResourceManager::set_renderer(SDL_Renderer *renderer) {
 
 bool ResourceManager::add_texture(const std::string &name,
                                   const std::filesystem::path &path) {
+    PROFILE_SCOPE("ResourceManager::add_texture");
     ASSERT_RET_MSG(_renderer, false, "renderer is null");
 
     if (_textures.find(name) != _textures.end()) {
@@ -44,6 +55,7 @@ bool ResourceManager::add_texture(const std::string &name,
         return false;
     }
 
+    tex->set_handle(_next_texture_handle++);
     _textures.emplace(name, std::move(tex));
     return true;
 }
@@ -65,6 +77,140 @@ bool ResourceManager::remove_texture(const std::string &name) {
     return true;
 }
 
+bool ResourceManager::build_atlas(const std::vector<std::string> &names,
+                                  u32 page_size) {
+    PROFILE_SCOPE("ResourceManager::build_atlas");
+    ASSERT_RET_MSG(_renderer, false, "renderer is null");
+
+    // one pixel gap so sampling never bleeds into a neighbour
+    constexpr i32 padding{1};
+    const i32 size{static_cast<i32>(page_size)};
+
+    struct Entry {
+        core::Texture2D *texture;
+        SDL_Surface *surface;
+        i32 x;
+        i32 y;
+        u32 page;
+    };
+
+    std::vector<Entry> entries;
+    for (const auto &name : names) {
+        auto it{_textures.find(name)};
+        if (it == _textures.end() || it->second->is_atlased()) {
+            spdlog::warn("texture '{}' cannot be atlased", name);
+            continue;
+        }
+
+        // the gpu copy cannot be read back, so the image is loaded again
+        const std::string path{it->second->get_path().string()};
+        SDL_Surface *surface{IMG_Load(path.c_str())};
+        if (!surface) {
+            spdlog::error("failed to load '{}' for atlas {}", name,
+                          SDL_GetError());
+            continue;
+        }
+        if (surface->w + 2 * padding > size ||
+            surface->h + 2 * padding > size) {
+            spdlog::warn("texture '{}' too large for a '{}' atlas page", name,
+                         page_size);
+            SDL_FreeSurface(surface);
+            continue;
+        }
+        entries.push_back({it->second.get(), surface, 0, 0, 0});
+    }
+    if (entries.empty()) return false;
+
+    // shelf packing, tallest first so shelves waste little height
+    std::sort(entries.begin(), entries.end(),
+              [](const Entry &a, const Entry &b) {
+                  if (a.surface->h != b.surface->h) {
+                      return a.surface->h > b.surface->h;
+                  }
+                  return a.texture->get_name() < b.texture->get_name();
+              });
+
+    u32 pages{1};
+    i32 x{padding};
+    i32 y{padding};
+    i32 shelf{0};
+    for (auto &entry : entries) {
+        const i32 w{entry.surface->w};
+        const i32 h{entry.surface->h};
+        if (x + w + padding > size) {
+            x = padding;
+            y += shelf + padding;
+            shelf = 0;
+        }
+        if (y + h + padding > size) {
+            ++pages;
+            x = padding;
+            y = padding;
+            shelf = 0;
+        }
+        entry.x = x;
+        entry.y = y;
+        entry.page = pages - 1;
+        x += w + padding;
+        shelf = std::max(shelf, h);
+    }
+
+    bool success{true};
+    for (u32 page = 0; page < pages; ++page) {
+        // pages are cropped to what they hold
+        i32 used_w{0};
+        i32 used_h{0};
+        for (const auto &entry : entries) {
+            if (entry.page != page) continue;
+            used_w = std::max(used_w, entry.x + entry.surface->w + padding);
+            used_h = std::max(used_h, entry.y + entry.surface->h + padding);
+        }
+
+        SDL_Surface *pixels{SDL_CreateRGBSurfaceWithFormat(
+            0, used_w, used_h, 32, SDL_PIXELFORMAT_RGBA32)};
+        if (!pixels) {
+            spdlog::error("failed to create atlas page {}", SDL_GetError());
+            success = false;
+            break;
+        }
+
+        for (const auto &entry : entries) {
+            if (entry.page != page) continue;
+            // copy alpha as is instead of blending onto the empty page
+            SDL_SetSurfaceBlendMode(entry.surface, SDL_BLENDMODE_NONE);
+            SDL_Rect dst{entry.x, entry.y, entry.surface->w, entry.surface->h};
+            SDL_BlitSurface(entry.surface, nullptr, pixels, &dst);
+        }
+
+        auto texture{std::make_unique<core::Texture2D>(
+            "atlas-" + std::to_string(_atlas_pages.size()),
+            std::filesystem::path())};
+        const bool initialized{texture->initialize(_renderer, pixels)};
+        SDL_FreeSurface(pixels);
+        if (!initialized) {
+            spdlog::error("failed to initialize atlas page '{}'",
+                          texture->get_name());
+            success = false;
+            break;
+        }
+
+        u32 count{0};
+        for (const auto &entry : entries) {
+            if (entry.page != page) continue;
+            entry.texture->set_atlas_region(*texture, entry.x, entry.y);
+            ++count;
+        }
+
+        texture->set_handle(_next_texture_handle++);
+        spdlog::debug("atlas page '{}' packed {} textures into '{}x{}'",
+                      texture->get_name(), count, used_w, used_h);
+        _atlas_pages.push_back(std::move(texture));
+    }
+
+    for (auto &entry : entries) SDL_FreeSurface(entry.surface);
+    return success;
+}
+
 bool ResourceManager::add_tilemap(explore::ecs::Registry &registry,
                                   const std::string &name, u32 tile_width,
                                   u32 tile_height, u32 tile_scale) {
@@ -97,9 +243,12 @@ bool ResourceManager::remove_tilemap(const std::string &name) {
     return true;
 }
 
-bool ResourceManager::load_tilemap(const std::string &name,
-                                   const std::filesystem::path &path,
-                                   const std::string &texture_name) {
+bool ResourceManager::load_tilemap(
+    const std::string &name, const std::filesystem::path &path,
+    const std::string &texture_name,
+    const std::filesystem::path &materials_path, u32 fill_width,
+    u32 fill_height) {
+    PROFILE_SCOPE("ResourceManager::load_tilemap");
     ASSERT_RET_MSG(_loaded_tilemap == "", false, "tilemap already loaded");
     auto it = _tilemaps.find(name);
     if (it == _tilemaps.end()) return false;
@@ -108,7 +257,8 @@ bool ResourceManager::load_tilemap(const std::string &name,
     ASSERT_RET_MSG(opt_texture.has_value(), false, "tilemap texture not found");
     const core::Texture2D &texture{opt_texture->get()};
 
-    if (it->second->load(path, texture)) {
+    if (it->second->load(path, texture, materials_path, fill_width,
+                         fill_height)) {
         _loaded_tilemap = it->second->name();
         return true;
     }
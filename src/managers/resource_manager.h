@@ -5,6 +5,7 @@
 #include <optional>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "../common.h"
 
@@ -25,7 +26,10 @@ class ResourceManager {
    private:
     std::unordered_map<std::string, std::unique_ptr<core::Texture2D>> _textures;
     std::unordered_map<std::string, std::unique_ptr<core::Tilemap>> _tilemaps;
+    // pages built by build_atlas, they own the pixels of atlased textures
+    std::vector<std::unique_ptr<core::Texture2D>> _atlas_pages;
     SDL_Renderer *_renderer;
+    u32 _next_texture_handle;
 
     std::string _loaded_tilemap;
 
@@ -41,6 +45,13 @@ class ResourceManager {
         const std::string &name) const;
     bool remove_texture(const std::string &name);
 
+    // packs the named textures into as few page_size x page_size atlas pages
+    // as possible. the textures keep their names and sizes and src rects keep
+    // addressing the original images, only the pixels move. textures that do
+    // not fit a page stay on their own
+    bool build_atlas(const std::vector<std::string> &names,
+                     u32 page_size = 2048u);
+
     bool add_tilemap(explore::ecs::Registry &registry, const std::string &name,
                      u32 tile_width, u32 tile_height, u32 tile_scale);
     std::optional<std::reference_wrapper<const core::Tilemap>> get_tilemap(
@@ -50,7 +61,9 @@ class ResourceManager {
 
     bool load_tilemap(const std::string &name,
                       const std::filesystem::path &path,
-                      const std::string &texture_name);
+                      const std::string &texture_name,
+                      const std::filesystem::path &materials_path = {},
+                      u32 fill_width = 0, u32 fill_height = 0);
 
     bool unload_tilemap(const std::string &name);
 
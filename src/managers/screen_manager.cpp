@@ -4,9 +4,14 @@
 #include <SDL2/SDL_image.h>
 #include <spdlog/spdlog.h>
 
+#include "../core/sprite_batch.h"
 #include "../core/texture2d.h"
 #include "./resource_manager.h"
 
+#if !SDL_VERSION_ATLEAST(2, 0, 18)
+#error "sprite batching needs SDL_RenderGeometry from SDL 2.0.18"
+#endif
+
 static u32 sdl_subsystem_flags{SDL_INIT_VIDEO | SDL_INIT_TIMER |
                                SDL_INIT_EVENTS};
 
@@ -15,8 +20,10 @@ namespace explore::manager {
 ScreenManager::ScreenManager()
     : _window(nullptr),
       _renderer(nullptr),
+      _surface(nullptr),
       _display_mode({}),
-      _dimensions(glm::ivec2(0)) {}
+      _dimensions(glm::ivec2(0)),
+      _headless(false) {}
 
 ScreenManager::~ScreenManager() {
     if (_renderer) {
@@ -24,6 +31,11 @@ ScreenManager::~ScreenManager() {
         _renderer = nullptr;
         spdlog::trace("destroyed SDL _renderer");
     }
+    if (_surface) {
+        SDL_FreeSurface(_surface);
+        _surface = nullptr;
+        spdlog::trace("destroyed offscreen surface");
+    }
     if (_window) {
         SDL_DestroyWindow(_window);
         _window = nullptr;
@@ -35,6 +47,9 @@ ScreenManager::~ScreenManager() {
 }
 
 bool ScreenManager::_initialize_sdl() {
+    // the dummy video driver needs no display, unless the environment
+    // already picked a driver
+    if (_headless) SDL_setenv("SDL_VIDEODRIVER", "dummy", 0);
     if (SDL_WasInit(sdl_subsystem_flags)) {
         spdlog::warn("SDL has already been initialized");
         return true;
@@ -53,7 +68,7 @@ bool ScreenManager::_initialize_sdl() {
 glm::ivec2 ScreenManager::get_dimensions() const { return _dimensions; }
 
 SDL_Window *ScreenManager::get_window() const {
-    ASSERT_RET(_window, nullptr);
+    ASSERT_RET(_window || _headless, nullptr);
     return _window;
 }
 
@@ -62,7 +77,8 @@ SDL_Renderer *ScreenManager::get_renderer() const {
     return _renderer;
 }
 
-bool ScreenManager::initialize() {
+bool ScreenManager::initialize(bool headless) {
+    _headless = headless;
     if (!_initialize_sdl()) {
         return false;
     }
@@ -72,6 +88,10 @@ bool ScreenManager::initialize() {
     //    dimensions.x = display_mode.w;
     //    dimensions.y = display_mode.h;
 
+    return _headless ? _initialize_offscreen() : _initialize_window();
+}
+
+bool ScreenManager::_initialize_window() {
     if (!_window) {
         _window = SDL_CreateWindow("Explore", SDL_WINDOWPOS_CENTERED,
                                    SDL_WINDOWPOS_CENTERED, _dimensions.x,
@@ -84,7 +104,8 @@ bool ScreenManager::initialize() {
                       _dimensions.y);
     }
     if (!_renderer) {
-        _renderer = SDL_CreateRenderer(_window, -1, SDL_RENDERER_ACCELERATED);
+        _renderer = SDL_CreateRenderer(
+            _window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_TARGETTEXTURE);
         if (!_renderer) {
             spdlog::error("failed to create SDL renderer {0}", SDL_GetError());
             SDL_DestroyWindow(_window);
@@ -96,11 +117,51 @@ bool ScreenManager::initialize() {
     return true;
 }
 
+bool ScreenManager::_initialize_offscreen() {
+    if (!_surface) {
+        _surface = SDL_CreateRGBSurfaceWithFormat(
+            0, _dimensions.x, _dimensions.y, 32, SDL_PIXELFORMAT_ARGB8888);
+        if (!_surface) {
+            spdlog::error("failed to create offscreen surface {0}",
+                          SDL_GetError());
+            return false;
+        }
+    }
+    if (!_renderer) {
+        _renderer = SDL_CreateSoftwareRenderer(_surface);
+        if (!_renderer) {
+            spdlog::error("failed to create SDL software renderer {0}",
+                          SDL_GetError());
+            SDL_FreeSurface(_surface);
+            _surface = nullptr;
+            return false;
+        }
+        spdlog::info("running headless ({0:d},{1:d})", _dimensions.x,
+                     _dimensions.y);
+    }
+    return true;
+}
+
 void ScreenManager::set_draw_color(const Color color) {
     ASSERT_RET_V(_renderer);
     SDL_SetRenderDrawColor(_renderer, color.r, color.g, color.b, color.a);
 }
 
+bool ScreenManager::supports_render_targets() const {
+    ASSERT_RET(_renderer, false);
+    return SDL_RenderTargetSupported(_renderer) == SDL_TRUE;
+}
+
+bool ScreenManager::set_render_target(const core::Texture2D *target) {
+    ASSERT_RET(_renderer, false);
+    if (SDL_SetRenderTarget(_renderer,
+                            target ? target->get_data() : nullptr) != 0) {
+        spdlog::error("failed to set render target {0}", SDL_GetError());
+        return false;
+    }
+    return true;
+}
+
 void ScreenManager::draw_rect(const SDL_Rect &dst, const Color color) {
     ASSERT_RET_V(_renderer);
     set_draw_color(color);
@@ -116,20 +177,34 @@ void ScreenManager::draw_rect_outline(const SDL_Rect &dst, const Color color) {
 void ScreenManager::draw_texture(const core::Texture2D &tex, SDL_Rect dst,
                                  f32 angle) const {
     ASSERT_RET_V(_renderer);
-    SDL_RenderCopyEx(_renderer, tex.get_data(), nullptr, &dst, angle, nullptr,
+    const SDL_Rect src{tex.get_region()};
+    SDL_RenderCopyEx(_renderer, tex.get_data(),
+                     tex.is_atlased() ? &src : nullptr, &dst, angle, nullptr,
                      SDL_FLIP_NONE);
 }
 
 void ScreenManager::draw_texture(const core::Texture2D &tex, SDL_Rect src,
                                  SDL_Rect dst, f32 angle) const {
     ASSERT_RET_V(_renderer);
+    // src addresses the original image, atlased textures shift it into place
+    src = tex.to_page(src);
     SDL_RenderCopyEx(_renderer, tex.get_data(), &src, &dst, angle, nullptr,
                      SDL_FLIP_NONE);
 }
 
-void ScreenManager::clear() {
+void ScreenManager::draw_batch(const core::SpriteBatch &batch) const {
+    ASSERT_RET_V(_renderer);
+    if (batch.empty() || !batch.texture()) return;
+    SDL_RenderGeometry(_renderer, batch.texture()->get_data(),
+                       batch.vertices().data(),
+                       static_cast<i32>(batch.vertices().size()),
+                       batch.indices().data(),
+                       static_cast<i32>(batch.indices().size()));
+}
+
+void ScreenManager::clear(const Color color) {
     ASSERT_RET_V(_renderer);
-    set_draw_color(color::black);
+    set_draw_color(color);
     SDL_RenderClear(_renderer);
 }
 
@@ -2,6 +2,7 @@
 #define EXPLORE_MANAGERS_SCREEN_MANAGER_H
 
 #include <SDL2/SDL_render.h>
+#include <SDL2/SDL_surface.h>
 #include <SDL2/SDL_video.h>
 
 #include <glm/glm.hpp>
@@ -10,7 +11,8 @@
 
 namespace explore::core {
 class Texture2D;
-}
+class SpriteBatch;
+}  // namespace explore::core
 
 namespace explore::manager {
 
@@ -18,11 +20,16 @@ class ScreenManager {
    private:
     SDL_Window *_window;
     SDL_Renderer *_renderer;
+    // target of the software renderer when running headless
+    SDL_Surface *_surface;
     SDL_DisplayMode _display_mode;
     glm::ivec2 _dimensions;
+    bool _headless;
 
    private:
     bool _initialize_sdl();
+    bool _initialize_window();
+    bool _initialize_offscreen();
 
    public:
     ScreenManager();
@@ -30,14 +37,25 @@ class ScreenManager {
 
     glm::ivec2 get_dimensions() const;
 
+    // null when headless
     SDL_Window *get_window() const;
 
     SDL_Renderer *get_renderer() const;
 
-    bool initialize();
+    bool is_headless() const { return _headless; }
+
+    // headless draws with the software renderer into an offscreen surface
+    // instead of opening a window, so it runs without a display
+    bool initialize(bool headless = false);
 
     void set_draw_color(Color color);
 
+    // true if textures can be used as render targets
+    bool supports_render_targets() const;
+
+    // redirects drawing into target, null restores the window
+    bool set_render_target(const core::Texture2D *target);
+
     void draw_rect(const SDL_Rect &dst, const Color color = color::white);
 
     void draw_rect_outline(const SDL_Rect &dst,
@@ -49,7 +67,10 @@ class ScreenManager {
     void draw_texture(const core::Texture2D &tex, SDL_Rect src, SDL_Rect dst,
                       f32 angle) const;
 
-    void clear();
+    // submits every quad of batch with one draw call
+    void draw_batch(const core::SpriteBatch &batch) const;
+
+    void clear(const Color color = color::black);
 
     void present() const;
 };
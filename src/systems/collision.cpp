@@ -1,47 +1,357 @@
 #include "collision.h"
 
-#include "../core/rect.h"
+#include <spdlog/spdlog.h>
+
+#include <cmath>
+
+#include "../core/job_pool.h"
+#include "../core/tilemap.h"
 #include "../ecs/components.h"
 #include "../events/bus.h"
 #include "../events/collision.h"
+#include "../events/tile_collision.h"
 
 namespace explore::system {
 
-Collision::Collision() {
+Collision::Collision()
+    : _broadphase(Broadphase::UniformGrid),
+      _grid(),
+      _simd_level(core::detect_simd_level()),
+      _overlap_batch(core::overlap_batch_fn(_simd_level)),
+      _boxes(),
+      _start_boxes(),
+      _motions(),
+      _continuous(),
+      _hits(),
+      _tasks(),
+      _job_pool(nullptr),
+      _bodies(),
+      _tree(),
+      _tilemap(nullptr),
+      _contacts(),
+      _emit_stay(false) {
     _name = "CollisionSystem";
 
     require_component<component::Transform>();
     require_component<component::BoxCollider>();
+
+    spdlog::debug("collision narrowphase using '{}'",
+                  core::simd_level_name(_simd_level));
+}
+
+void Collision::set_simd_level(core::SimdLevel level) {
+    _overlap_batch = core::overlap_batch_fn(level);
+    _simd_level = level;
+}
+
+void Collision::add_entity(ecs::Entity entity) {
+    System::add_entity(entity);
+
+    const auto &transform{entity.get_component<component::Transform>()};
+    const auto &collider{entity.get_component<component::BoxCollider>()};
+    const core::AABB box{core::aabb(transform, collider)};
+
+    auto body{_bodies.find(entity.get_id())};
+    if (body != _bodies.end()) {
+        body->second.aabb = box;
+        body->second.layer = collider.layer;
+        _tree.move_proxy(body->second.proxy, box);
+        return;
+    }
+
+    _bodies.emplace(entity.get_id(),
+                    Body{entity, _tree.create_proxy(box, entity.get_id()), box,
+                         collider.layer});
+}
+
+bool Collision::remove_entity(ecs::Entity entity) {
+    auto body{_bodies.find(entity.get_id())};
+    if (body != _bodies.end()) {
+        _tree.destroy_proxy(body->second.proxy);
+        _bodies.erase(body);
+    }
+    // handlers cannot safely inspect a killed entity, so its contacts are
+    // dropped without a CollisionExit
+    _contacts.remove(entity.get_id());
+    return System::remove_entity(entity);
 }
 
 void Collision::update(event::Bus &event_bus) {
+    _update_boxes();
+    _contacts.begin_frame();
+
+    switch (_broadphase) {
+        case Broadphase::BruteForce:
+            _brute_force(event_bus);
+            break;
+        case Broadphase::UniformGrid:
+            _uniform_grid(event_bus);
+            break;
+    }
+
+    // contacts not reported this frame have separated
+    _contacts.sweep([&](u32 a, u32 b) {
+        event_bus.emit<event::CollisionExit>(_bodies.at(a).entity,
+                                             _bodies.at(b).entity);
+    });
+
+    if (_tilemap) {
+        _tile_collisions(event_bus);
+    }
+}
+
+bool Collision::_swept_hit(u32 a, u32 b) const {
+    f32 toi{0.f};
+    return core::swept_intersect(_start_boxes[a], _motions[a], _start_boxes[b],
+                                 _motions[b], toi);
+}
+
+void Collision::_tile_collisions(event::Bus &event_bus) {
     const auto &entities = get_entities();
-    const size_t count = entities.size();
+    const core::AABBArrays boxes{_boxes.view()};
+    const f32 tile_w{static_cast<f32>(_tilemap->scaled_tile_width())};
+    const f32 tile_h{static_cast<f32>(_tilemap->scaled_tile_height())};
+    constexpr u32 tile_layers{layer::WATER | layer::TERRAIN};
 
-    // TODO: N^2 is fine for now; optimizations can come later
-    for (size_t i = 0; i < count; ++i) {
-        ecs::Entity a = entities[i];
-        const auto &ta = a.get_component<component::Transform>();
-        const auto &ca = a.get_component<component::BoxCollider>();
+    // each collider only looks at the cells it covers, so the cost does not
+    // depend on the size of the map
+    for (u32 i = 0; i < _boxes.size(); ++i) {
+        const u32 mask{boxes.mask[i] & tile_layers};
+        if (mask == layer::NONE) continue;
 
-        SDL_Rect ra = core::rect(ta, ca);
+        const i32 x0{static_cast<i32>(std::floor(boxes.min_x[i] / tile_w))};
+        const i32 y0{static_cast<i32>(std::floor(boxes.min_y[i] / tile_h))};
+        const i32 x1{static_cast<i32>(std::ceil(boxes.max_x[i] / tile_w))};
+        const i32 y1{static_cast<i32>(std::ceil(boxes.max_y[i] / tile_h))};
 
-        for (size_t j = i + 1; j < count; ++j) {
-            ecs::Entity b = entities[j];
-            const auto &tb = b.get_component<component::Transform>();
-            const auto &cb = b.get_component<component::BoxCollider>();
+        // continuous colliders cover their whole step, so the first tile
+        // along the sweep is reported rather than the first one scanned
+        bool hit{false};
+        f32 best_toi{2.f};
+        i32 hit_x{0};
+        i32 hit_y{0};
+        core::TileMaterial hit_material{core::TileMaterial::None};
 
-            SDL_Rect rb = core::rect(tb, cb);
+        for (i32 y = y0; y < y1; ++y) {
+            for (i32 x = x0; x < x1; ++x) {
+                const core::TileMaterial material{_tilemap->material_at(x, y)};
+                if ((core::material_layer(material) & mask) == 0) continue;
 
-            if (aabb_intersect(ra, rb)) {
-                event_bus.emit<event::Collision>(a, b);
+                f32 toi{0.f};
+                if (_continuous[i]) {
+                    const glm::vec2 cell_min{x * tile_w, y * tile_h};
+                    const core::AABB cell{cell_min,
+                                          cell_min + glm::vec2(tile_w, tile_h)};
+                    if (!core::swept_intersect(_start_boxes[i], _motions[i],
+                                               cell, glm::vec2(0), toi)) {
+                        continue;
+                    }
+                }
+
+                if (toi < best_toi) {
+                    hit = true;
+                    best_toi = toi;
+                    hit_x = x;
+                    hit_y = y;
+                    hit_material = material;
+                }
             }
         }
+
+        if (hit) {
+            event_bus.emit<event::TileCollision>(entities[i], hit_x, hit_y,
+                                                 hit_material);
+        }
     }
 }
 
-bool Collision::aabb_intersect(const SDL_Rect &a, const SDL_Rect &b) {
-    return (a.x < b.x + b.w && a.x + a.w > b.x && a.y < b.y + b.h &&
-            a.y + a.h > b.y);
+void Collision::_report(u32 a, u32 b, event::Bus &event_bus) {
+    // continuous colliders overlap over the whole step, the pair only
+    // touched if the sweeps actually met
+    if ((_continuous[a] || _continuous[b]) && !_swept_hit(a, b)) return;
+
+    const auto &entities = get_entities();
+    if (_contacts.touch(entities[a].get_id(), entities[b].get_id())) {
+        event_bus.emit<event::CollisionEnter>(entities[a], entities[b]);
+    } else if (_emit_stay) {
+        event_bus.emit<event::CollisionStay>(entities[a], entities[b]);
+    }
+}
+
+void Collision::_update_boxes() {
+    const auto &entities = get_entities();
+    const u32 count{static_cast<u32>(entities.size())};
+    _boxes.resize(count);
+    _start_boxes.resize(count);
+    _motions.resize(count);
+    _continuous.resize(count);
+
+    for (u32 i = 0; i < count; ++i) {
+        const auto &transform{
+            entities[i].get_component<component::Transform>()};
+        const auto &collider{
+            entities[i].get_component<component::BoxCollider>()};
+        const core::AABB box{core::aabb(transform, collider)};
+
+        // motion is measured against the box the body had at the end of the
+        // last update, so moves made outside Movement or by entities without
+        // a RigidBody are swept over one step only
+        auto body{_bodies.find(entities[i].get_id())};
+        const glm::vec2 motion{
+            body != _bodies.end() ? box.min - body->second.aabb.min
+                                  : glm::vec2(0.f)};
+
+        _start_boxes[i] = core::AABB(box.min - motion, box.max - motion);
+        _motions[i] = motion;
+        _continuous[i] = collider.continuous ? 1 : 0;
+
+        // continuous colliders enter the broadphase with the box swept over
+        // the whole step so nothing they passed through is missed
+        _boxes.set(i,
+                   collider.continuous
+                       ? core::AABB::combine(_start_boxes[i], box)
+                       : box,
+                   collider.layer, collider.mask);
+
+        // the tree only reinserts bodies that left their fattened box
+        if (body != _bodies.end()) {
+            body->second.aabb = box;
+            body->second.layer = collider.layer;
+            _tree.move_proxy(body->second.proxy, box);
+        }
+    }
+}
+
+void Collision::query_region(const SDL_Rect &region,
+                             std::vector<ecs::Entity> &out, u32 mask) const {
+    const core::AABB box{core::aabb(region)};
+    _tree.query(box, [&](u32 id) {
+        const Body &body{_bodies.at(id)};
+        if ((body.layer & mask) != 0 && body.aabb.overlaps(box)) {
+            out.push_back(body.entity);
+        }
+        return true;
+    });
+}
+
+std::optional<RaycastHit> Collision::raycast(glm::vec2 from, glm::vec2 to,
+                                             u32 mask) const {
+    std::optional<RaycastHit> hit{std::nullopt};
+    _tree.raycast(from, to, [&](u32 id, f32 max_fraction) {
+        const Body &body{_bodies.at(id)};
+        f32 fraction{0.f};
+        if ((body.layer & mask) == 0 ||
+            !core::segment_intersect(body.aabb, from, to, fraction) ||
+            fraction >= max_fraction) {
+            return max_fraction;
+        }
+        hit = RaycastHit{body.entity, from + (to - from) * fraction, fraction};
+        return fraction;
+    });
+    return hit;
+}
+
+void Collision::_brute_force(event::Bus &event_bus) {
+    const u32 count{_boxes.size()};
+    _hits.resize(count);
+
+    for (u32 i = 0; i + 1 < count; ++i) {
+        const u32 hits{_overlap_batch(_boxes.query(i), _boxes.view(i + 1),
+                                      count - i - 1, _hits.data())};
+        for (u32 h = 0; h < hits; ++h) {
+            _report(i, i + 1 + _hits[h], event_bus);
+        }
+    }
+}
+
+void Collision::_uniform_grid(event::Bus &event_bus) {
+    const core::AABBArrays boxes{_boxes.view()};
+
+    _grid.clear();
+    for (u32 i = 0; i < _boxes.size(); ++i) {
+        // colliders that interact with nothing never enter the grid
+        if (boxes.layer[i] == layer::NONE || boxes.mask[i] == layer::NONE) {
+            continue;
+        }
+        _grid.insert(i, _boxes.get(i));
+    }
+    _grid.build();
+
+    // more tasks than threads so one dense range does not stall the batch.
+    // without a pool everything stays in one task on this thread
+    const bool parallel{_job_pool && _boxes.size() >= _parallel_threshold};
+    _partition_cells(parallel ? _job_pool->thread_count() * 4 : 1u);
+
+    if (_tasks.size() > 1) {
+        _job_pool->parallel_for(static_cast<u32>(_tasks.size()),
+                                [this](u32 i) { _find_pairs(_tasks[i]); });
+    } else {
+        _find_pairs(_tasks[0]);
+    }
+
+    // tasks cover the cells in order, so merging them in task order yields
+    // the serial pair order no matter how the jobs were scheduled
+    for (const auto &task : _tasks) {
+        for (const auto &[a, b] : task.pairs) {
+            _report(a, b, event_bus);
+        }
+    }
+}
+
+void Collision::_partition_cells(u32 task_count) {
+    const auto &cells{_grid.cells()};
+    const u32 cell_count{static_cast<u32>(cells.size())};
+    if (task_count > cell_count) task_count = cell_count > 0 ? cell_count : 1;
+
+    // a cell costs roughly one kernel lane per candidate pair
+    u64 total{0};
+    for (const auto &cell : cells) {
+        total += static_cast<u64>(cell.count) * cell.count;
+    }
+
+    _tasks.resize(task_count);
+
+    u32 begin{0};
+    u64 done{0};
+    for (u32 t = 0; t < task_count; ++t) {
+        const u64 target{total * (t + 1) / task_count};
+        u32 end{begin};
+        while (end < cell_count && (done < target || t + 1 == task_count)) {
+            done += static_cast<u64>(cells[end].count) * cells[end].count;
+            ++end;
+        }
+        _tasks[t].cell_begin = begin;
+        _tasks[t].cell_end = end;
+        begin = end;
+    }
+}
+
+void Collision::_find_pairs(PairTask &task) const {
+    const auto &cells{_grid.cells()};
+    task.pairs.clear();
+
+    for (u32 c = task.cell_begin; c < task.cell_end; ++c) {
+        const auto &cell{cells[c]};
+        if (cell.count < 2) continue;
+
+        const u32 *indices{_grid.cell_indices(cell)};
+        // pack the cell occupants so the kernel reads contiguous memory
+        task.cell_boxes.gather(_boxes, indices, cell.count);
+        if (task.hits.size() < cell.count) task.hits.resize(cell.count);
+
+        for (u32 i = 0; i + 1 < cell.count; ++i) {
+            const u32 a{indices[i]};
+            const u32 hits{_overlap_batch(_boxes.query(a),
+                                          task.cell_boxes.view(i + 1),
+                                          cell.count - i - 1,
+                                          task.hits.data())};
+            for (u32 h = 0; h < hits; ++h) {
+                const u32 b{indices[i + 1 + task.hits[h]]};
+                if (_grid.owns_pair(a, b, cell.x, cell.y)) {
+                    task.pairs.emplace_back(a, b);
+                }
+            }
+        }
+    }
 }
 };  // namespace explore::system
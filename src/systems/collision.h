@@ -1,23 +1,151 @@
 #ifndef EXPLORE_SYSTEMS_COLLISION_H_
 #define EXPLORE_SYSTEMS_COLLISION_H_
 
+#include <SDL_rect.h>
+
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "../core/aabb.h"
+#include "../core/aabb_tree.h"
+#include "../core/contact_cache.h"
+#include "../core/simd_aabb.h"
+#include "../core/spatial_grid.h"
 #include "../ecs/ecs.h"
 
-class SDL_Rect;
+namespace explore::core {
+class JobPool;
+class Tilemap;
+}  // namespace explore::core
 
 namespace explore::event {
 class Bus;
 }
 
 namespace explore::system {
+
+// strategy used to produce candidate pairs for the narrowphase
+enum class Broadphase {
+    // tests every pair, kept as a reference to verify the other strategies
+    BruteForce,
+    // only tests pairs that share a cell in a uniform grid
+    UniformGrid
+};
+
+// closest collider crossed by a raycast
+struct RaycastHit {
+    ecs::Entity entity;
+    glm::vec2 point;
+    // position of the hit along the ray in [0, 1]
+    f32 fraction;
+};
+
 class Collision : public ecs::System {
    public:
     Collision();
 
+    void add_entity(ecs::Entity entity) override;
+    bool remove_entity(ecs::Entity entity) override;
+
     void update(event::Bus &event_bus);
 
+    // collects every entity whose collider overlaps region (world space) and
+    // whose layer is part of mask
+    void query_region(const SDL_Rect &region, std::vector<ecs::Entity> &out,
+                      u32 mask = layer::ALL) const;
+
+    // returns the first collider on a layer in mask crossed by from->to
+    std::optional<RaycastHit> raycast(glm::vec2 from, glm::vec2 to,
+                                      u32 mask = layer::ALL) const;
+
+    Broadphase get_broadphase() const { return _broadphase; }
+    void set_broadphase(Broadphase broadphase) { _broadphase = broadphase; }
+
+    // size of a broadphase grid cell, usually the scaled tilemap tile size
+    u32 get_cell_size() const { return _grid.cell_size(); }
+    void set_cell_size(u32 cell_size) { _grid.set_cell_size(cell_size); }
+
+    // tilemap whose material grid colliders are tested against, tiles never
+    // enter the broadphase. may be null
+    void set_tilemap(const core::Tilemap *tilemap) { _tilemap = tilemap; }
+
+    // emit CollisionStay every frame a contact persists, off by default
+    bool get_emit_stay() const { return _emit_stay; }
+    void set_emit_stay(bool emit_stay) { _emit_stay = emit_stay; }
+
+    // pool the grid broadphase spreads its cells over, may be null to run
+    // everything on the calling thread. pair order does not depend on it
+    void set_job_pool(core::JobPool *job_pool) { _job_pool = job_pool; }
+
+    // narrowphase kernel, defaults to the best one the cpu supports
+    core::SimdLevel get_simd_level() const { return _simd_level; }
+    void set_simd_level(core::SimdLevel level);
+
+   private:
+    Broadphase _broadphase;
+    core::SpatialGrid _grid;
+
+    core::SimdLevel _simd_level;
+    core::OverlapBatchFn _overlap_batch;
+
+    // world box and layer filter of every entity in _entities order,
+    // refreshed once per update. continuous colliders are stored swept from
+    // their box at the previous update
+    core::AABBBuffer _boxes;
+    // box at the start of the step, movement over the step and whether the
+    // collider is continuous, in _entities order
+    std::vector<core::AABB> _start_boxes;
+    std::vector<glm::vec2> _motions;
+    std::vector<u8> _continuous;
+    // hit indices written by the narrowphase kernel, sized by _brute_force
+    std::vector<u32> _hits;
+
+    // contiguous range of grid cells tested by one job, with its own scratch
+    // and pair output so jobs never share memory
+    struct PairTask {
+        u32 cell_begin;
+        u32 cell_end;
+        // occupants of the grid cell being tested
+        core::AABBBuffer cell_boxes;
+        std::vector<u32> hits;
+        std::vector<std::pair<u32, u32>> pairs;
+    };
+
+    // below this many bodies the grid is tested on the calling thread
+    static constexpr u32 _parallel_threshold{1024u};
+
+    std::vector<PairTask> _tasks;
+    core::JobPool *_job_pool;
+
+    struct Body {
+        ecs::Entity entity;
+        i32 proxy;
+        // tight box, the tree only knows about the fattened one
+        core::AABB aabb;
+        u32 layer;
+    };
+
+    // bodies keyed by entity id, kept in sync with the aabb tree
+    std::unordered_map<u32, Body> _bodies;
+    core::AABBTree _tree;
+
+    const core::Tilemap *_tilemap;
+
+    // pairs overlapping as of the last update, keyed by entity ids
+    core::ContactCache _contacts;
+    bool _emit_stay;
+
    private:
-    static bool aabb_intersect(const SDL_Rect &a, const SDL_Rect &b);
+    void _update_boxes();
+    void _brute_force(event::Bus &event_bus);
+    void _uniform_grid(event::Bus &event_bus);
+    void _partition_cells(u32 task_count);
+    void _find_pairs(PairTask &task) const;
+    void _report(u32 a, u32 b, event::Bus &event_bus);
+    bool _swept_hit(u32 a, u32 b) const;
+    void _tile_collisions(event::Bus &event_bus);
 };
 }  // namespace explore::system
 
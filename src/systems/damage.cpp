@@ -5,6 +5,7 @@
 #include "../ecs/components.h"
 #include "../events/bus.h"
 #include "../events/collision.h"
+#include "../events/tile_collision.h"
 
 namespace explore::system {
 
@@ -14,10 +15,20 @@ Damage::Damage() {
 }
 
 void Damage::subscribe_to_events(event::Bus &event_bus) {
-    event_bus.on<event::Collision>(this, &Damage::on_collision);
+    // projectiles only need to be handled once per contact
+    event_bus.on<event::CollisionEnter>(this, &Damage::on_collision);
+    event_bus.on<event::TileCollision>(this, &Damage::on_tile_collision);
 }
 
-void Damage::on_collision(event::Collision &event) {
+void Damage::on_tile_collision(event::TileCollision &event) {
+    // projectiles fly over water but not through solid terrain
+    if (event.material == core::TileMaterial::Solid &&
+        event.entity.has_component<component::Projectile>()) {
+        event.entity.kill();
+    }
+}
+
+void Damage::on_collision(event::CollisionEnter &event) {
     spdlog::trace("collision between '{}:{}' and '{}:{}'", event.a.get_id(),
                   event.a.get_name(), event.b.get_id(), event.b.get_name());
 
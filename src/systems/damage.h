@@ -5,7 +5,8 @@
 
 namespace explore::event {
 class Bus;
-class Collision;
+class CollisionEnter;
+class TileCollision;
 }  // namespace explore::event
 
 namespace explore::system {
@@ -15,7 +16,9 @@ class Damage : public ecs::System {
 
     virtual void subscribe_to_events(event::Bus &event_bus) override;
 
-    void on_collision(event::Collision &event);
+    void on_collision(event::CollisionEnter &event);
+
+    void on_tile_collision(event::TileCollision &event);
 
     void update();
 
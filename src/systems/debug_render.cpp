@@ -13,13 +13,22 @@ DebugRender::DebugRender() {
     require_component<component::BoxCollider>();
 }
 
-void DebugRender::update(manager::ScreenManager &screen_manager) {
+void DebugRender::extract(core::RenderSnapshot &snapshot, f32 alpha) {
+    snapshot.debug_rects.clear();
     for (const auto &entity : get_entities()) {
-        const auto &transform = entity.get_component<component::Transform>();
+        auto transform{entity.get_component<component::Transform>()};
         const auto &box_collider{
             entity.get_component<component::BoxCollider>()};
 
-        const auto rect = core::rect(transform, box_collider);
+        transform.position = transform.interpolated_position(alpha);
+
+        snapshot.debug_rects.push_back(core::rect(transform, box_collider));
+    }
+}
+
+void DebugRender::submit(manager::ScreenManager &screen_manager,
+                         const core::RenderSnapshot &snapshot) {
+    for (const SDL_Rect &rect : snapshot.debug_rects) {
         screen_manager.draw_rect_outline(rect, color::green);
     }
 }
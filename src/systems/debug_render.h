@@ -1,6 +1,7 @@
 #ifndef EXPLORE_SYSTEMS_DEBUG_RENDER_H_
 #define EXPLORE_SYSTEMS_DEBUG_RENDER_H_
 
+#include "../core/render_snapshot.h"
 #include "../ecs/ecs.h"
 
 namespace explore::manager {
@@ -12,7 +13,11 @@ class DebugRender : public ecs::System {
    public:
     DebugRender();
 
-    void update(manager::ScreenManager &screen_manager);
+    // outlines follow the interpolated position sprites are drawn at
+    void extract(core::RenderSnapshot &snapshot, f32 alpha);
+
+    void submit(manager::ScreenManager &screen_manager,
+                const core::RenderSnapshot &snapshot);
 };
 }  // namespace explore::system
 
@@ -16,6 +16,7 @@ void Movement::update(f32 delta_time) {
         auto &transform{entity.get_component<component::Transform>()};
         const auto rb{entity.get_component<component::RigidBody>()};
 
+        transform.previous_position = transform.position;
         transform.position += (rb.velocity * delta_time);
     }
 }
@@ -9,6 +9,15 @@
 
 namespace explore::system {
 
+// friendly projectiles only interact with enemies, the rest with the player.
+// both are stopped by solid terrain and are swept since they are small and fast
+static component::BoxCollider projectile_collider(bool friendly) {
+    return component::BoxCollider(
+        4u, 4u, glm::vec2(0),
+        friendly ? layer::PLAYER_PROJECTILE : layer::ENEMY_PROJECTILE,
+        (friendly ? layer::ENEMY : layer::PLAYER) | layer::TERRAIN, true);
+}
+
 ProjectileEmit::ProjectileEmit() {
     _name = "ProjectileEmitSystem";
 
@@ -69,7 +78,8 @@ void ProjectileEmit::on_key_pressed(event::KeyPressed &event) {
                 projectile.add_component<component::Sprite>(
                     "bullet-tex", 5u, core::rect(0, 0, 4, 4));
 
-                projectile.add_component<component::BoxCollider>(4u, 4u);
+                projectile.add_component<component::BoxCollider>(
+                    projectile_collider(emitter.friendly));
             }
         }
     }
@@ -107,7 +117,8 @@ void ProjectileEmit::update(ecs::Registry &registry) {
             projectile.add_component<component::Sprite>("bullet-tex", 5u,
                                                         core::rect(0, 0, 4, 4));
 
-            projectile.add_component<component::BoxCollider>(4u, 4u);
+            projectile.add_component<component::BoxCollider>(
+                projectile_collider(emitter.friendly));
 
             emitter.last_emission_time = SDL_GetTicks();
         }
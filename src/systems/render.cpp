@@ -1,5 +1,10 @@
 #include "render.h"
 
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cmath>
+
 #include "../core/rect.h"
 #include "../core/texture2d.h"
 #include "../ecs/components.h"
@@ -8,7 +13,28 @@
 
 namespace explore::system {
 
-Render::Render() {
+// world space box covered by the sprite, rotated sprites are bounded by the
+// circle they sweep around their center
+static core::AABB sprite_box(const component::Transform &transform,
+                             const component::Sprite &sprite,
+                             const glm::vec2 &position) {
+    const glm::vec2 size{sprite.src_rect.w * transform.scale.x,
+                         sprite.src_rect.h * transform.scale.y};
+    if (transform.rotation == 0.0) {
+        return core::AABB(position, position + size);
+    }
+
+    const glm::vec2 center{position + size * 0.5f};
+    const f32 radius{0.5f * std::sqrt(size.x * size.x + size.y * size.y)};
+    return core::AABB(center - glm::vec2(radius), center + glm::vec2(radius));
+}
+
+Render::Render()
+    : _sprites(),
+      _tree(),
+      _next_depth(0),
+      _clamped_sprites(0),
+      _batch() {
     _name = "RenderSystem";
 
     require_component<component::Transform>();
@@ -16,42 +42,132 @@ Render::Render() {
 }
 
 void Render::add_entity(ecs::Entity entity) {
-    int z = entity.get_component<component::Sprite>().z_index;
+    const auto &transform{entity.get_component<component::Transform>()};
+    const auto &sprite{entity.get_component<component::Sprite>()};
 
-    auto it = std::lower_bound(
-        _entities.begin(), _entities.end(), z,
-        [&](const ecs::Entity &e, int z_value) {
-            return e.get_component<component::Sprite>().z_index < z_value;
-        });
+    // draw order is worked out per frame, so nothing is kept sorted here
+    System::add_entity(entity);
 
-    _entities.insert(it, entity);
+    _sprites.insert_or_assign(
+        entity.get_id(),
+        SpriteProxy{entity,
+                    _tree.create_proxy(
+                        sprite_box(transform, sprite, transform.position),
+                        entity.get_id()),
+                    _next_depth++});
 }
 
-void Render::update(const manager::ScreenManager &screen_manager,
-                    const manager::ResourceManager &resource_manager,
-                    const SDL_Rect &camera) {
-    for (const auto &entity : get_entities()) {
-        const auto transform = entity.get_component<component::Transform>();
-        const auto sprite{entity.get_component<component::Sprite>()};
+bool Render::remove_entity(ecs::Entity entity) {
+    auto sprite{_sprites.find(entity.get_id())};
+    if (sprite != _sprites.end()) {
+        _tree.destroy_proxy(sprite->second.proxy);
+        _sprites.erase(sprite);
+    }
+    return System::remove_entity(entity);
+}
+
+void Render::extract(core::RenderSnapshot &snapshot,
+                     const manager::ResourceManager &resource_manager,
+                     f32 alpha) {
+    const SDL_Rect &camera{snapshot.camera};
+    const core::AABB view{
+        glm::vec2(camera.x, camera.y),
+        glm::vec2(camera.x + camera.w, camera.y + camera.h)};
+
+    // refitting is cheap, proxies only move in the tree once they leave
+    // their fattened box
+    for (const auto &[id, sprite] : _sprites) {
+        const auto &transform{
+            sprite.entity.get_component<component::Transform>()};
+        _tree.move_proxy(
+            sprite.proxy,
+            sprite_box(transform,
+                       sprite.entity.get_component<component::Sprite>(),
+                       transform.interpolated_position(alpha)));
+    }
+
+    core::CommandBuffer &commands{snapshot.sprites};
+    commands.clear();
+    snapshot.sprite_stats = {0, 0, 0};
 
-        if (transform.scale.x == 0 && transform.scale.y == 0) continue;
+    u32 clamped{0};
+    _tree.query(view, [&](u32 id) {
+        const SpriteProxy &visible{_sprites.at(id)};
+        const auto &transform{
+            visible.entity.get_component<component::Transform>()};
+        const auto &sprite{visible.entity.get_component<component::Sprite>()};
 
+        if (transform.scale.x == 0 && transform.scale.y == 0) return true;
+
+        // a sprite without its texture is skipped, the rest still draw
         auto opt_texture{resource_manager.get_texture(sprite.texture_name)};
-        ASSERT_RET_V(opt_texture.has_value());
+        if (!opt_texture.has_value()) {
+            spdlog::error("sprite '{}' has missing texture '{}'",
+                          visible.entity.get_name(), sprite.texture_name);
+            return true;
+        }
         const core::Texture2D &texture{opt_texture->get()};
 
+        if (sprite.z_index > core::CommandBuffer::max_layer) ++clamped;
+
         const auto scaled_w =
             static_cast<u32>(sprite.src_rect.w * transform.scale.x);
         const auto scaled_h =
             static_cast<u32>(sprite.src_rect.h * transform.scale.y);
 
-        const auto position{glm::vec2(transform.position.x - camera.x,
-                                      transform.position.y - camera.y)};
+        const auto position{transform.interpolated_position(alpha) -
+                            glm::vec2(camera.x, camera.y)};
+
+        // the z index is read every frame, so changing it just works
+        commands.push(
+            core::CommandBuffer::make_key(sprite.z_index,
+                                          texture.get_page().get_handle(),
+                                          visible.depth),
+            {&texture, sprite.src_rect,
+             core::rect(position, scaled_w, scaled_h), transform.rotation});
+        return true;
+    });
 
-        screen_manager.draw_texture(texture, sprite.src_rect,
-                                    core::rect(position, scaled_w, scaled_h),
-                                    transform.rotation);
+    if (clamped != _clamped_sprites && clamped > 0) {
+        spdlog::warn("{} sprites have a z index clamped to {}", clamped,
+                     core::CommandBuffer::max_layer);
     }
+    _clamped_sprites = clamped;
+
+    // sorting here keeps the renderer to issuing draw calls
+    commands.sort();
+
+    snapshot.sprite_stats.drawn = commands.size();
+    snapshot.sprite_stats.culled =
+        static_cast<u32>(_sprites.size()) - commands.size();
+}
+
+void Render::submit(const manager::ScreenManager &screen_manager,
+                    core::RenderSnapshot &snapshot) {
+    const core::CommandBuffer &commands{snapshot.sprites};
+    core::RenderStats &stats{snapshot.sprite_stats};
+
+    u64 batch_key{0};
+    for (u32 i = 0; i < commands.size(); ++i) {
+        const core::DrawCommand &command{commands.command(i)};
+        // layer and texture bits, depth only orders inside a batch
+        const u64 key{commands.key(i) >> 32};
+        if (i == 0 || key != batch_key) {
+            _flush(screen_manager, stats);
+            _batch.begin(*command.texture);
+            batch_key = key;
+        }
+        _batch.add(*command.texture, command.src, command.dst, command.angle);
+    }
+    _flush(screen_manager, stats);
+}
+
+void Render::_flush(const manager::ScreenManager &screen_manager,
+                    core::RenderStats &stats) {
+    if (_batch.empty()) return;
+    screen_manager.draw_batch(_batch);
+    _batch.clear();
+    ++stats.batches;
 }
 
 }  // namespace explore::system
@@ -3,6 +3,13 @@
 
 #include <SDL_rect.h>
 
+#include <unordered_map>
+#include <vector>
+
+#include "../core/aabb.h"
+#include "../core/aabb_tree.h"
+#include "../core/render_snapshot.h"
+#include "../core/sprite_batch.h"
 #include "../ecs/ecs.h"
 
 namespace explore::manager {
@@ -11,15 +18,47 @@ class ResourceManager;
 }  // namespace explore::manager
 
 namespace explore::system {
+// draws sprites overlapping the camera. sprites live in an aabb tree queried
+// with the camera, so draw calls follow what is visible rather than the world
+// size. extract records the visible sprites of the simulation into the
+// snapshot command buffer keyed by z index, texture page and insertion order
+// and radix sorts it. submit runs on the renderer and sends each run of the
+// same z index and page as one batch. tilemaps are drawn by TilemapRender
 class Render : public ecs::System {
    public:
     Render();
 
     void add_entity(ecs::Entity entity) override;
+    bool remove_entity(ecs::Entity entity) override;
+
+    // sprites are placed alpha of the way from their previous position to
+    // their current one
+    void extract(core::RenderSnapshot &snapshot,
+                 const manager::ResourceManager &resource_manager, f32 alpha);
+
+    void submit(const manager::ScreenManager &screen_manager,
+                core::RenderSnapshot &snapshot);
+
+   private:
+    struct SpriteProxy {
+        ecs::Entity entity;
+        i32 proxy;
+        // insertion order, breaks ties between sprites of a layer and page
+        u32 depth;
+    };
+
+    std::unordered_map<u32, SpriteProxy> _sprites;
+    core::AABBTree _tree;
+    u32 _next_depth;
+    // sprites over CommandBuffer::max_layer last frame, warned on change
+    u32 _clamped_sprites;
+
+    // only touched by submit
+    core::SpriteBatch _batch;
 
-    void update(const manager::ScreenManager &screen_manager,
-                const manager::ResourceManager &resource_manager,
-                const SDL_Rect &camera);
+   private:
+    void _flush(const manager::ScreenManager &screen_manager,
+                core::RenderStats &stats);
 };
 }  // namespace explore::system
 
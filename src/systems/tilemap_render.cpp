@@ -0,0 +1,244 @@
+#include "tilemap_render.h"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <string>
+
+#include "../core/rect.h"
+#include "../core/texture2d.h"
+#include "../ecs/components.h"
+#include "../managers/resource_manager.h"
+#include "../managers/screen_manager.h"
+
+namespace explore::system {
+
+TilemapRender::TilemapRender() : _caches(), _batch() {
+    _name = "TilemapRenderSystem";
+
+    require_component<component::Tilemap>();
+}
+
+TilemapRender::~TilemapRender() = default;
+
+void TilemapRender::extract(core::RenderSnapshot &snapshot,
+                            const manager::ResourceManager &resource_manager) {
+    const auto &entities{get_entities()};
+    snapshot.tilemaps.resize(entities.size());
+
+    for (u32 i = 0; i < entities.size(); ++i) {
+        auto &tilemap{entities[i].get_component<component::Tilemap>()};
+        core::TilemapSnapshot &slot{snapshot.tilemaps[i]};
+
+        auto opt_texture{resource_manager.get_texture(tilemap.texture_name)};
+        ASSERT_RET_V(opt_texture.has_value());
+        slot.tileset = &opt_texture->get();
+
+        // every snapshot is drawn, so each edit reaches the renderer once
+        slot.edited_chunks.swap(tilemap.edited_chunks);
+        tilemap.edited_chunks.clear();
+
+        // the grid is only copied when it differs from the slot's copy
+        if (slot.tilemap.generation != tilemap.generation ||
+            slot.tilemap.revision != tilemap.revision) {
+            slot.tilemap = tilemap;
+        }
+    }
+}
+
+void TilemapRender::submit(manager::ScreenManager &screen_manager,
+                           core::RenderSnapshot &snapshot) {
+    snapshot.tile_stats = {0, 0, 0};
+
+    const bool use_chunks{screen_manager.supports_render_targets()};
+
+    for (const core::TilemapSnapshot &slot : snapshot.tilemaps) {
+        const component::Tilemap &tilemap{slot.tilemap};
+        if (tilemap.tile_width == 0 || tilemap.tile_height == 0) continue;
+
+        if (use_chunks) {
+            _draw_chunks(screen_manager, slot, snapshot.camera,
+                         snapshot.tile_stats);
+        } else {
+            _draw_tiles(screen_manager, *slot.tileset, tilemap,
+                        snapshot.camera, snapshot.tile_stats);
+        }
+    }
+
+    // chunks of tilemaps that left the simulation
+    for (auto it = _caches.begin(); it != _caches.end();) {
+        const bool live{std::any_of(
+            snapshot.tilemaps.begin(), snapshot.tilemaps.end(),
+            [&](const core::TilemapSnapshot &slot) {
+                return slot.tilemap.generation == it->first;
+            })};
+        it = live ? std::next(it) : _caches.erase(it);
+    }
+}
+
+void TilemapRender::invalidate() { _caches.clear(); }
+
+TilemapRender::ChunkCache &TilemapRender::_cache(
+    const core::TilemapSnapshot &snapshot) {
+    const component::Tilemap &tilemap{snapshot.tilemap};
+    auto &cache{_caches[tilemap.generation]};
+
+    // a new map invalidates everything, otherwise only edited chunks
+    if (cache.columns != tilemap.chunk_columns() ||
+        cache.rows != tilemap.chunk_rows()) {
+        cache.columns = tilemap.chunk_columns();
+        cache.rows = tilemap.chunk_rows();
+        cache.textures.clear();
+        cache.textures.resize(cache.columns * cache.rows);
+        cache.dirty.assign(cache.columns * cache.rows, 1);
+    }
+
+    for (const u32 chunk : snapshot.edited_chunks) {
+        if (chunk < cache.dirty.size()) cache.dirty[chunk] = 1;
+    }
+
+    return cache;
+}
+
+bool TilemapRender::_bake(manager::ScreenManager &screen_manager,
+                          const core::Texture2D &tileset,
+                          const component::Tilemap &tilemap, ChunkCache &cache,
+                          u32 chunk) {
+    constexpr u32 size{component::Tilemap::chunk_size};
+    const u32 x0{(chunk % cache.columns) * size};
+    const u32 y0{(chunk / cache.columns) * size};
+    const u32 x1{std::min(tilemap.map_width, x0 + size)};
+    const u32 y1{std::min(tilemap.map_height, y0 + size)};
+
+    // chunks are baked at tileset resolution and scaled when drawn. edge
+    // chunks only cover the tiles that exist
+    auto &texture{cache.textures[chunk]};
+    if (!texture) {
+        texture = std::make_unique<core::Texture2D>(
+            tilemap.texture_name + "-chunk-" + std::to_string(chunk),
+            std::filesystem::path());
+        if (!texture->initialize_target(screen_manager.get_renderer(),
+                                        (x1 - x0) * tilemap.tile_width,
+                                        (y1 - y0) * tilemap.tile_height)) {
+            texture.reset();
+            return false;
+        }
+    }
+
+    ASSERT_RET(screen_manager.set_render_target(texture.get()), false);
+    screen_manager.clear({0, 0, 0, 0});
+
+    for (u32 y = y0; y < y1; ++y) {
+        for (u32 x = x0; x < x1; ++x) {
+            const u16 tile{tilemap.tile_at(x, y)};
+            if (tile == component::Tilemap::empty_tile) continue;
+
+            screen_manager.draw_texture(
+                tileset, tilemap.src_rect(tile),
+                core::rect((x - x0) * tilemap.tile_width,
+                           (y - y0) * tilemap.tile_height, tilemap.tile_width,
+                           tilemap.tile_height),
+                0.f);
+        }
+    }
+
+    screen_manager.set_render_target(nullptr);
+    cache.dirty[chunk] = 0;
+    return true;
+}
+
+void TilemapRender::_draw_chunks(manager::ScreenManager &screen_manager,
+                                 const core::TilemapSnapshot &snapshot,
+                                 const SDL_Rect &camera,
+                                 core::RenderStats &stats) {
+    const core::Texture2D &tileset{*snapshot.tileset};
+    const component::Tilemap &tilemap{snapshot.tilemap};
+    ChunkCache &cache{_cache(snapshot)};
+
+    constexpr i32 size{static_cast<i32>(component::Tilemap::chunk_size)};
+    const i32 tile_w{static_cast<i32>(tilemap.tile_width) *
+                     static_cast<i32>(tilemap.tile_scale)};
+    const i32 tile_h{static_cast<i32>(tilemap.tile_height) *
+                     static_cast<i32>(tilemap.tile_scale)};
+    const i32 chunk_w{tile_w * size};
+    const i32 chunk_h{tile_h * size};
+    const i32 columns{static_cast<i32>(cache.columns)};
+    const i32 rows{static_cast<i32>(cache.rows)};
+
+    // chunk rectangle covered by the camera, clamped to the map
+    const i32 x0{std::max(0, camera.x / chunk_w)};
+    const i32 y0{std::max(0, camera.y / chunk_h)};
+    const i32 x1{
+        std::min(columns, (camera.x + camera.w + chunk_w - 1) / chunk_w)};
+    const i32 y1{
+        std::min(rows, (camera.y + camera.h + chunk_h - 1) / chunk_h)};
+
+    u32 drawn{0};
+    for (i32 y = y0; y < y1; ++y) {
+        for (i32 x = x0; x < x1; ++x) {
+            const u32 chunk{static_cast<u32>(y * columns + x)};
+            if (cache.dirty[chunk] &&
+                !_bake(screen_manager, tileset, tilemap, cache, chunk)) {
+                continue;
+            }
+
+            const core::Texture2D &texture{*cache.textures[chunk]};
+            screen_manager.draw_texture(
+                texture,
+                core::rect(x * chunk_w - camera.x, y * chunk_h - camera.y,
+                           texture.get_width() * tilemap.tile_scale,
+                           texture.get_height() * tilemap.tile_scale),
+                0.f);
+            ++drawn;
+        }
+    }
+
+    stats.drawn += drawn;
+    stats.culled += columns * rows - drawn;
+    stats.batches += drawn;
+}
+
+void TilemapRender::_draw_tiles(const manager::ScreenManager &screen_manager,
+                                const core::Texture2D &tileset,
+                                const component::Tilemap &tilemap,
+                                const SDL_Rect &camera,
+                                core::RenderStats &stats) {
+    const i32 tile_w{static_cast<i32>(tilemap.tile_width) *
+                     static_cast<i32>(tilemap.tile_scale)};
+    const i32 tile_h{static_cast<i32>(tilemap.tile_height) *
+                     static_cast<i32>(tilemap.tile_scale)};
+    const i32 map_w{static_cast<i32>(tilemap.map_width)};
+    const i32 map_h{static_cast<i32>(tilemap.map_height)};
+
+    // tile rectangle covered by the camera, clamped to the map
+    const i32 x0{std::max(0, camera.x / tile_w)};
+    const i32 y0{std::max(0, camera.y / tile_h)};
+    const i32 x1{std::min(map_w, (camera.x + camera.w + tile_w - 1) / tile_w)};
+    const i32 y1{std::min(map_h, (camera.y + camera.h + tile_h - 1) / tile_h)};
+
+    // every visible tile shares the tileset, so they go out as one batch
+    _batch.begin(tileset);
+    for (i32 y = y0; y < y1; ++y) {
+        for (i32 x = x0; x < x1; ++x) {
+            const u16 tile{tilemap.tile_at(x, y)};
+            if (tile == component::Tilemap::empty_tile) continue;
+
+            _batch.add(tileset, tilemap.src_rect(tile),
+                       core::rect(x * tile_w - camera.x, y * tile_h - camera.y,
+                                  tile_w, tile_h),
+                       0.0);
+        }
+    }
+
+    const u32 drawn{_batch.size()};
+    if (drawn > 0) {
+        screen_manager.draw_batch(_batch);
+        ++stats.batches;
+    }
+    _batch.clear();
+
+    stats.drawn += drawn;
+    stats.culled += static_cast<u32>(tilemap.tiles.size()) - drawn;
+}
+
+}  // namespace explore::system
@@ -0,0 +1,71 @@
+#ifndef EXPLORE_SYSTEMS_TILEMAP_RENDER_H_
+#define EXPLORE_SYSTEMS_TILEMAP_RENDER_H_
+
+#include <SDL_rect.h>
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "../core/render_snapshot.h"
+#include "../core/sprite_batch.h"
+#include "../ecs/ecs.h"
+
+namespace explore::manager {
+class ScreenManager;
+class ResourceManager;
+}  // namespace explore::manager
+
+namespace explore::system {
+// draws tilemap grids below every sprite. extract copies the grids into the
+// snapshot, only after an edit, together with the chunks the edit touched.
+// on the renderer, blocks of chunk_size x chunk_size tiles are baked into a
+// texture the first time they are seen and after every edit, so a frame only
+// copies the few chunks under the camera. without render target support the
+// visible tiles are drawn one by one instead
+class TilemapRender : public ecs::System {
+   public:
+    TilemapRender();
+    ~TilemapRender();
+
+    void extract(core::RenderSnapshot &snapshot,
+                 const manager::ResourceManager &resource_manager);
+
+    void submit(manager::ScreenManager &screen_manager,
+                core::RenderSnapshot &snapshot);
+
+    // drops every baked chunk, they are rebaked when next seen. needed when
+    // the renderer loses its target contents and before it is destroyed
+    void invalidate();
+
+   private:
+    // baked chunks of one tilemap entity, textures are created lazily
+    struct ChunkCache {
+        u32 columns;
+        u32 rows;
+        std::vector<std::unique_ptr<core::Texture2D>> textures;
+        std::vector<u8> dirty;
+    };
+
+    // renderer side, keyed by the generation of the tilemap they bake
+    std::unordered_map<u32, ChunkCache> _caches;
+    // visible tiles when drawing without chunks
+    core::SpriteBatch _batch;
+
+   private:
+    ChunkCache &_cache(const core::TilemapSnapshot &snapshot);
+    bool _bake(manager::ScreenManager &screen_manager,
+               const core::Texture2D &tileset,
+               const component::Tilemap &tilemap, ChunkCache &cache,
+               u32 chunk);
+    void _draw_chunks(manager::ScreenManager &screen_manager,
+                      const core::TilemapSnapshot &snapshot,
+                      const SDL_Rect &camera, core::RenderStats &stats);
+    void _draw_tiles(const manager::ScreenManager &screen_manager,
+                     const core::Texture2D &tileset,
+                     const component::Tilemap &tilemap,
+                     const SDL_Rect &camera, core::RenderStats &stats);
+};
+}  // namespace explore::system
+
+#endif  // EXPLORE_SYSTEMS_TILEMAP_RENDER_H_